@@ -0,0 +1,43 @@
+#ifndef CODE_AUTOMORPHISM_HPP
+#define CODE_AUTOMORPHISM_HPP
+
+#include <vector>
+#include <cstddef>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Column automorphisms of a parity-check matrix. A permutation perm of the
+ * n columns (perm[c] is the image of column c) is an automorphism of H if
+ * some permutation of the rows maps H onto H with its columns permuted,
+ * i.e. the set of rows (as column sets) is preserved. Such a permutation
+ * preserves the energy E(x) of every state, so states in one orbit share
+ * their minimal barrier from 0.
+ */
+
+// Whether perm is a column automorphism of H
+bool isColumnAutomorphism(const ParityCheckMatrix& H, const std::vector<int>& perm);
+
+/*
+ * Generating set of the column automorphisms of H that map the support of
+ * fixedWord onto itself (pass a length-n word; all zeros fixes nothing).
+ *
+ * Individualization-refinement on the Tanner graph: colour refinement
+ * gives an equitable partition of bits and checks, base points are fixed
+ * one at a time, and for each point of the base point's cell that is not
+ * yet in its orbit a backtracking search looks for an automorphism
+ * mapping one to the other. Every returned permutation is verified with
+ * isColumnAutomorphism. The search stops after maxNodes refinement nodes,
+ * so on very regular graphs the set may generate only a subgroup.
+ */
+std::vector<std::vector<int>> findColumnAutomorphisms(const ParityCheckMatrix& H,
+                                                      const std::vector<int>& fixedWord,
+                                                      std::size_t maxNodes = 200000);
+
+/*
+ * Elements of the group generated by generators (identity included),
+ * found breadth first and capped at maxElements.
+ */
+std::vector<std::vector<int>> permutationGroupElements(const std::vector<std::vector<int>>& generators,
+                                                       int n, std::size_t maxElements);
+
+#endif // CODE_AUTOMORPHISM_HPP
@@ -0,0 +1,47 @@
+#ifndef CODE_COMPONENTS_HPP
+#define CODE_COMPONENTS_HPP
+
+#include <vector>
+#include "parity_check_matrix.hpp"
+
+/*
+ * A connected component of the Tanner graph of H: its bits (columns) and
+ * checks (rows), each in increasing order. A bit that no check touches is
+ * a component of its own with no checks.
+ */
+struct TannerComponent {
+    std::vector<int> cols;
+    std::vector<int> rows;
+};
+
+// Connected components of the Tanner graph, ordered by their smallest bit
+std::vector<TannerComponent> tannerComponents(const ParityCheckMatrix& H);
+
+/*
+ * The rows and columns of H belonging to the given bits and checks, with
+ * local indices (column k of the result is cols[k], row k is rows[k]).
+ */
+ParityCheckMatrix subParityCheck(const ParityCheckMatrix& H, const std::vector<int>& rows,
+                                 const std::vector<int>& cols);
+
+/*
+ * Energy barrier from 0 to c_target, split along the Tanner-graph
+ * components of H.
+ *
+ * The energy of a state is the sum of the energies of its restrictions to
+ * the components, and the restriction of any path to one component is a
+ * path there with no higher energy at any step. So:
+ *  - components where c_target is zero are dropped;
+ *  - a component where c_target restricts to a codeword is solved on its
+ *    own; it starts and ends at energy 0, so these can be done one after
+ *    another and the barrier is the largest of theirs;
+ *  - the remaining components (c_target has nonzero energy there) are
+ *    solved together as one smaller code, after the codeword parts.
+ * The result equals computeEnergyBarrier on H, but each search only pays
+ * for the state space of one part. Parts are solved in parallel with
+ * OpenMP when called outside a parallel region.
+ */
+int computeEnergyBarrierDecomposed(const ParityCheckMatrix& H, const std::vector<int>& c_target);
+int computeEnergyBarrierDecomposed(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target);
+
+#endif // CODE_COMPONENTS_HPP
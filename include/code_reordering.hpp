@@ -0,0 +1,58 @@
+#ifndef CODE_REORDERING_HPP
+#define CODE_REORDERING_HPP
+
+#include <vector>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Standalone utility: no search applies these orderings by itself. A
+ * caller that wants the banded layout permutes H and the target with
+ * permuteParityCheck/permuteState, runs any barrier search on the result
+ * (barriers are invariant under the permutation) and maps flip paths back
+ * with unpermuteFlipPath.
+ */
+
+/*
+ * A simultaneous permutation of the bits (columns) and checks (rows) of H.
+ * colPerm[j] is the original column placed at position j, colInverse[c]
+ * is the new position of original column c; likewise for rows.
+ */
+struct CodeOrdering {
+    std::vector<int> colPerm;
+    std::vector<int> colInverse;
+    std::vector<int> rowPerm;
+    std::vector<int> rowInverse;
+};
+
+/*
+ * Reverse Cuthill–McKee ordering of the Tanner graph of H (bits and checks
+ * as one bipartite graph). Each connected component is traversed
+ * breadth-first from a pseudo-peripheral node, visiting neighbours by
+ * increasing degree, and the resulting sequence is reversed. Bits that
+ * share checks end up at nearby positions, which keeps each row of H in a
+ * narrow band of packed words.
+ */
+CodeOrdering reverseCuthillMcKee(const ParityCheckMatrix& H);
+
+// The identity ordering for an ℓ x n matrix
+CodeOrdering identityOrdering(int rows, int cols);
+
+/*
+ * Largest column span of a row, max_r (last column - first column) of
+ * row r; the quantity the reordering tries to reduce.
+ */
+int parityCheckBandwidth(const ParityCheckMatrix& H);
+
+// H with its rows and columns rearranged according to ord
+ParityCheckMatrix permuteParityCheck(const ParityCheckMatrix& H, const CodeOrdering& ord);
+
+// Map a length-n state or codeword from original to reordered positions
+std::vector<int> permuteState(const std::vector<int>& x, const CodeOrdering& ord);
+
+// Map a length-n state or codeword from reordered back to original positions
+std::vector<int> unpermuteState(const std::vector<int>& x, const CodeOrdering& ord);
+
+// Map a flip path (sequence of flipped bit indices) back to original indices
+std::vector<int> unpermuteFlipPath(const std::vector<int>& path, const CodeOrdering& ord);
+
+#endif // CODE_REORDERING_HPP
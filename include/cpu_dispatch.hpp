@@ -0,0 +1,58 @@
+#ifndef CPU_DISPATCH_HPP
+#define CPU_DISPATCH_HPP
+
+#include <string>
+
+/*
+ * Instruction-set levels for the GF(2) kernels, roughly following the
+ * x86-64 micro-architecture levels:
+ *   Generic - portable C++, any CPU
+ *   Popcnt  - hardware POPCNT
+ *   Avx2    - AVX2 + POPCNT + BMI2 (Haswell and later)
+ *   Avx512  - AVX-512 F/BW on top of Avx2
+ * Every binary contains all levels; the best one supported by the CPU is
+ * chosen at startup from CPUID, so one build runs on mixed clusters.
+ */
+enum class Gf2Isa { Generic = 0, Popcnt = 1, Avx2 = 2, Avx512 = 3 };
+
+/*
+ * Helpers for writing one kernel body and compiling it at every level:
+ * the body is a GF2_FORCE_INLINE function, and thin wrappers tagged with
+ * GF2_TARGET_* inline it so the compiler emits that level's instructions.
+ * The x86 targets only exist when GF2_HAVE_X86_KERNELS is defined.
+ */
+#define GF2_FORCE_INLINE inline __attribute__((always_inline))
+#if defined(__x86_64__) || defined(__i386__)
+#define GF2_HAVE_X86_KERNELS 1
+#define GF2_TARGET_POPCNT __attribute__((target("popcnt")))
+#define GF2_TARGET_AVX2 __attribute__((target("avx2,popcnt,bmi,bmi2")))
+#define GF2_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,popcnt,bmi,bmi2")))
+#endif
+
+// Highest level supported by the running CPU
+Gf2Isa detectGf2Isa();
+
+/*
+ * Level currently used by the kernels. Defaults to detectGf2Isa(), unless
+ * the environment variable GF2_ISA (generic, popcnt, avx2, avx512) asks
+ * for a lower one. GF2_ISA is read once at program startup; an unknown
+ * value is ignored with a warning on stderr.
+ */
+Gf2Isa activeGf2Isa();
+
+/*
+ * Force a specific level, e.g. to benchmark implementations against each
+ * other. Throws std::invalid_argument if the CPU does not support it.
+ */
+void forceGf2Isa(Gf2Isa isa);
+
+// True if the running CPU can execute kernels of level isa
+bool gf2IsaSupported(Gf2Isa isa);
+
+// "generic", "popcnt", "avx2" or "avx512"
+std::string gf2IsaName(Gf2Isa isa);
+
+// Inverse of gf2IsaName; throws std::invalid_argument on unknown names
+Gf2Isa parseGf2Isa(const std::string& name);
+
+#endif // CPU_DISPATCH_HPP
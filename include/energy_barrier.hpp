@@ -5,13 +5,190 @@
 #include <unordered_map>
 #include <queue>
 #include <string>
+#include <cstddef>
+#include <limits>
+#include "parity_check_matrix.hpp"
+#include "search_limits.hpp"
 
 // Function to compute the syndrome H*x^T over GF(2) and return its Hamming weight.
 int energyOfState(const std::vector<std::vector<int>>& H, const std::vector<int>& x);
 
+// Sparse overload, O(nnz) per state.
+int energyOfState(const ParityCheckMatrix& H, const std::vector<int>& x);
+
 // Function to compute the minimal energy barrier from the zero codeword to c_target by single-bit flips.
 int computeEnergyBarrier(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target);
 
+// Sparse overload; the search walks the CSC columns of H directly and
+// dispatches to the smallest computeEnergyBarrierFixed<W> that fits, or to
+// a run-time-width search (packed_search.hpp) for codes with more than
+// 1024 bits or checks.
+int computeEnergyBarrier(const ParityCheckMatrix& H, const std::vector<int>& c_target);
+
+/*
+ * computeEnergyBarrier with an incumbent: upperBound is a barrier the
+ * caller already knows to be achievable (a heuristic path, the factor
+ * bound of a tensor product, another codeword's result). States with
+ * energy >= upperBound are never pushed, so only the region that could
+ * beat the bound is searched. Returns min(barrier, upperBound), i.e. the
+ * exact barrier whenever upperBound is a valid bound.
+ * Throws std::invalid_argument if upperBound < 0.
+ */
+int computeEnergyBarrier(const ParityCheckMatrix& H, const std::vector<int>& c_target, int upperBound);
+int computeEnergyBarrier(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target, int upperBound);
+
+// Width-specialized search with states held in W 64-bit words (W = 1, 2, 4, 8, 16).
+// Requires n <= 64*W and ℓ <= 64*W.
+template<int W>
+int computeEnergyBarrierFixed(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                              int upperBound = std::numeric_limits<int>::max());
+
+/*
+ * Energy barrier from the zero codeword to every codeword in one search.
+ *
+ * The barrier is a minimax (bottleneck) path value, so flooding the
+ * hypercube from 0 in order of nondecreasing path peak reaches each
+ * codeword c exactly at its barrier. One flood that runs until the last
+ * listed codeword is reached replaces one search per codeword.
+ *
+ * Parameters:
+ * H - parity-check matrix (ℓ x n)
+ * codewords - '0'/'1' strings of length n, e.g. from computeAllCodewordsGF2
+ *
+ * Returns:
+ * barriers[k] for codewords[k] (0 for the zero codeword), or -1 for a
+ * word the search cannot reach
+ */
+std::vector<int> computeEnergyBarrierProfile(const ParityCheckMatrix& H,
+                                             const std::vector<std::string>& codewords);
+
+std::vector<int> computeEnergyBarrierProfile(const std::vector<std::vector<int>>& H,
+                                             const std::vector<std::string>& codewords);
+
+/*
+ * Energy barrier of the code: the minimum over nonzero codewords c of the
+ * barrier from 0 to c, without enumerating the codewords.
+ *
+ * Floods outward from 0 in order of nondecreasing path peak (each
+ * threshold level extends the region explored so far) and stops at the
+ * first reached state with zero syndrome other than 0.
+ *
+ * Parameters:
+ * H - parity-check matrix (ℓ x n)
+ * codeword - optional output, a nonzero codeword attaining the barrier
+ *
+ * Returns:
+ * The code's energy barrier, or -1 if the code has no nonzero codeword
+ */
+int computeCodeEnergyBarrier(const ParityCheckMatrix& H);
+int computeCodeEnergyBarrier(const ParityCheckMatrix& H, std::vector<int>& codeword);
+int computeCodeEnergyBarrier(const std::vector<std::vector<int>>& H);
+int computeCodeEnergyBarrier(const std::vector<std::vector<int>>& H, std::vector<int>& codeword);
+
+/*
+ * Same result as computeEnergyBarrier, searching from both ends.
+ *
+ * For a codeword c, E(x ^ c) = E(x), so the frontier grown backward from
+ * c is the mirror of the forward one and both come out of a single flood
+ * at no extra energy evaluations. The search stops when the frontiers
+ * meet at the current peak threshold instead of when the forward one
+ * reaches c. Falls back to computeEnergyBarrier if c_target is not a
+ * codeword.
+ */
+int computeEnergyBarrierBidirectional(const ParityCheckMatrix& H, const std::vector<int>& c_target);
+int computeEnergyBarrierBidirectional(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target);
+
+/*
+ * Same result as computeEnergyBarrier, searching one representative per
+ * orbit of the column automorphisms of H that fix c_target (found with
+ * findColumnAutomorphisms, code_automorphism.hpp). Symmetric states are
+ * explored once, which shrinks the visited set by up to the group order
+ * for tensor products and cyclic codes. At most maxGroupElements group
+ * elements are used for canonicalization; each costs O(|x|) per state.
+ */
+int computeEnergyBarrierSymmetric(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                  std::size_t maxGroupElements = 1024);
+int computeEnergyBarrierSymmetric(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                  std::size_t maxGroupElements = 1024);
+
+/*
+ * computeEnergyBarrierSymmetric with the symmetry supplied by the caller:
+ * groupElements are column automorphisms of H (perm[c] = image of column
+ * c) that all fix c_target, e.g. the rotations of a quasi-cyclic code.
+ * The identity may be included; it is skipped.
+ */
+int computeEnergyBarrierWithSymmetry(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                     const std::vector<std::vector<int>>& groupElements);
+
+/*
+ * Decide whether the energy barrier from 0 to c_target is below T, i.e.
+ * whether some single-bit-flip path keeps every state at energy < T.
+ * Only states with energy < T are explored (breadth first), so rejecting
+ * a threshold is much cheaper than computing the barrier exactly.
+ *
+ * Parameters:
+ * H - parity-check matrix (ℓ x n)
+ * c_target - length-n target state
+ * T - energy threshold
+ * flipPath - optional output; on success the bit indices flipped, in
+ *            order, along a witness path from 0 to c_target
+ *
+ * Returns:
+ * true iff the barrier is < T
+ */
+bool energyBarrierBelow(const ParityCheckMatrix& H, const std::vector<int>& c_target, int T);
+bool energyBarrierBelow(const ParityCheckMatrix& H, const std::vector<int>& c_target, int T,
+                        std::vector<int>& flipPath);
+bool energyBarrierBelow(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target, int T);
+bool energyBarrierBelow(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target, int T,
+                        std::vector<int>& flipPath);
+
+/*
+ * computeEnergyBarrier and energyBarrierBelow with a deadline, work budget
+ * and/or cancellation flag (search_limits.hpp). The limits are checked
+ * before every state expansion; on expiry the call returns at once with
+ * status saying which limit hit, the states expanded so far, and bounds:
+ *
+ * computeEnergyBarrierLimited - lower bound: the peak level the flood had
+ *     reached (and E(c_target)); upper bound: the peak of a greedy flip
+ *     path. Complete results carry the exact barrier. An upperBound
+ *     prunes the flood as in computeEnergyBarrier(H, c_target, upperBound).
+ * energyBarrierBelowLimited - when decided, upperBound = T - 1 (barrier
+ *     below T) or lowerBound = T (not below); when stopped, only
+ *     lowerBound = E(c_target) is known.
+ */
+BarrierResult computeEnergyBarrierLimited(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                          const SearchLimits& limits,
+                                          int upperBound = std::numeric_limits<int>::max());
+BarrierResult computeEnergyBarrierLimited(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                          const SearchLimits& limits,
+                                          int upperBound = std::numeric_limits<int>::max());
+BarrierResult energyBarrierBelowLimited(const ParityCheckMatrix& H, const std::vector<int>& c_target, int T,
+                                        const SearchLimits& limits);
+BarrierResult energyBarrierBelowLimited(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                        int T, const SearchLimits& limits);
+
+/*
+ * Storage backend for the visited states of computeEnergyBarrier.
+ *
+ * Hash  - open-addressing table keyed by the packed state (any n).
+ * Dense - flat array indexed by the state's integer value, one byte per
+ *         state (two if ℓ >= 255); only used for n <= maxDenseVisitedBits().
+ * Auto  - Dense when the 2^n array fits denseVisitedBudget(), else Hash.
+ *
+ * Both settings are process-wide and default to Auto with a 256 MiB budget.
+ */
+enum class VisitedStorage { Auto, Hash, Dense };
+
+void setVisitedStorage(VisitedStorage storage);
+VisitedStorage visitedStorage();
+
+void setDenseVisitedBudget(std::size_t bytes);
+std::size_t denseVisitedBudget();
+
+// Largest n for which the dense backend is ever used
+constexpr int maxDenseVisitedBits() { return 34; }
+
 
 
 #endif // ENERGY_BARRIER_HPP
\ No newline at end of file
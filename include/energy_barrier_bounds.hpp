@@ -0,0 +1,91 @@
+#ifndef ENERGY_BARRIER_BOUNDS_HPP
+#define ENERGY_BARRIER_BOUNDS_HPP
+
+#include <vector>
+#include <utility>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Bits a support-restricted search may flip: supp(c_target) plus up to
+ * slackBits further bits taken from its Tanner-graph neighbourhood. Bits
+ * sharing a check with the chosen set are added ring by ring, and inside
+ * a ring those sharing more checks with it come first.
+ *
+ * Returns:
+ * The allowed bit indices in increasing order
+ */
+std::vector<int> supportNeighbourhoodBits(const ParityCheckMatrix& H,
+                                          const std::vector<int>& c_target,
+                                          int slackBits);
+
+/*
+ * Upper bound on the energy barrier from 0 to c_target obtained by only
+ * flipping the bits of supportNeighbourhoodBits(H, c_target, slackBits).
+ *
+ * The search runs on the columns of those bits alone, so its space is
+ * about 2^(|c| + slackBits) states however long the code is. Every path
+ * it finds is a path of the full code with the same energies, so the
+ * result is a valid upper bound, nonincreasing in slackBits and exact
+ * once the allowed set contains an optimal path. The allowed set always
+ * contains supp(c_target), so a path always exists. Passing the result as
+ * upperBound to computeEnergyBarrier prunes the exact search to states
+ * that can still beat it.
+ *
+ * Returns:
+ * The bound
+ */
+int computeEnergyBarrierRestricted(const ParityCheckMatrix& H,
+                                   const std::vector<int>& c_target,
+                                   int slackBits);
+
+int computeEnergyBarrierRestricted(const std::vector<std::vector<int>>& H,
+                                   const std::vector<int>& c_target,
+                                   int slackBits);
+
+/*
+ * Upper bound on the energy barrier from 0 to c_target from a beam search
+ * of width beamWidth, for codes far too large for computeEnergyBarrier.
+ *
+ * Paths are grown one flip per depth. Of all one-flip extensions of the
+ * states in the beam, the beamWidth best distinct states survive, ranked
+ * by path peak, then current energy, then Hamming distance to c_target.
+ * A flip may move away from c_target up to detourFlips times (so paths
+ * have at most |c_target| + 2*detourFlips flips); with detourFlips = 0
+ * every flip is a bit of supp(c_target). The search keeps only the beam,
+ * its candidate extensions and one parent link per kept state and depth,
+ * i.e. O(beamWidth * n) memory, and beamWidth = 1 is a greedy path.
+ *
+ * Parameters:
+ * beamWidth - states kept per depth (>= 1)
+ * detourFlips - flips away from c_target allowed per path (>= 0)
+ * flipPath - optional output; the bit indices flipped, in order, along
+ *            the path whose peak is returned
+ *
+ * Returns:
+ * The peak energy of the best path found. Throws std::invalid_argument
+ * for a bad width, detour count or target length.
+ */
+int computeEnergyBarrierBeam(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                             int beamWidth, int detourFlips = 0);
+int computeEnergyBarrierBeam(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                             int beamWidth, int detourFlips, std::vector<int>& flipPath);
+int computeEnergyBarrierBeam(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                             int beamWidth, int detourFlips = 0);
+int computeEnergyBarrierBeam(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                             int beamWidth, int detourFlips, std::vector<int>& flipPath);
+
+/*
+ * How the beam bound improves with the width: runs computeEnergyBarrierBeam
+ * for beamWidth = 1, 2, 4, ... up to maxBeamWidth (always included). Each
+ * run only keeps paths that beat the previous bound, so the bounds are
+ * nonincreasing and wide runs prune early. (A single wider beam is not
+ * always better: it can fill with low-peak prefixes that all stall.)
+ *
+ * Returns:
+ * (beamWidth, bound) pairs in increasing width
+ */
+std::vector<std::pair<int,int>> computeEnergyBarrierBeamSweep(const ParityCheckMatrix& H,
+                                                              const std::vector<int>& c_target,
+                                                              int maxBeamWidth, int detourFlips = 0);
+
+#endif // ENERGY_BARRIER_BOUNDS_HPP
@@ -2,6 +2,7 @@
 #define ENERGY_BARRIER_EXHAUST_HPP
 
 #include <vector>
+#include "search_limits.hpp"
 
 /*
  * Compute the number of violated parity checks for state x
@@ -30,6 +31,31 @@ int computeEnergyBarrierExhaustive(
     const std::vector<int>& c_target
 );
 
+/*
+ * Same search seeded with an incumbent: upperBound is a barrier the caller
+ * already knows to be achievable. Paths are cut as soon as their peak
+ * reaches the incumbent, which every completed path tightens. Returns
+ * min(barrier, upperBound). Throws std::invalid_argument if
+ * upperBound < 0.
+ */
+int computeEnergyBarrierExhaustive(
+    const std::vector<std::vector<int>>& H,
+    const std::vector<int>& c_target,
+    int upperBound
+);
+
+/*
+ * Same search under SearchLimits (deadline, budget of DFS calls,
+ * cancellation). On expiry the recursion unwinds at once; the result
+ * carries the best completed path as upper bound and E(c_target) as lower
+ * bound (see BarrierResult).
+ */
+BarrierResult computeEnergyBarrierExhaustive(
+    const std::vector<std::vector<int>>& H,
+    const std::vector<int>& c_target,
+    const SearchLimits& limits
+);
+
 /*
  * Helper function for recursive path exploration in brute force approach
  */
@@ -0,0 +1,88 @@
+#ifndef ENERGY_BARRIER_EXTERNAL_HPP
+#define ENERGY_BARRIER_EXTERNAL_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Settings of the external-memory search.
+ *
+ * directory    - where scratch files go; a private subdirectory is created
+ *                there and removed afterwards. Empty means $TMPDIR or /tmp.
+ * memoryBudget - bytes of states held in memory at once (the candidate
+ *                buffer); everything else lives in files.
+ * maxRuns      - visited or candidate runs kept before they are merged into
+ *                one, which bounds the number of files read at once.
+ * checkpointDirectory - if set, the run files are kept in this directory
+ *                (created if missing) instead of a private one, and a
+ *                checkpoint is recorded there at most every
+ *                checkpointInterval seconds (0: after every round). The
+ *                search only ever writes and deletes the files run<N>,
+ *                checkpoint and checkpoint.tmp there, and deletes its
+ *                files once it returns a result; anything else in the
+ *                directory is left alone. A dedicated directory is still
+ *                the safest choice.
+ */
+struct ExternalSearchConfig {
+    std::string directory;
+    std::size_t memoryBudget = std::size_t(1) << 30;
+    int maxRuns = 32;
+    std::string checkpointDirectory;
+    double checkpointInterval = 60;
+};
+
+/*
+ * Energy barrier from 0 to c_target with the search state on disk, for
+ * codes whose visited set does not fit in RAM.
+ *
+ * The flood is level synchronous like computeEnergyBarrierParallel:
+ * states of path peak P are expanded breadth first in rounds before any
+ * state of peak P + 1. All states (frontiers, states waiting for a higher
+ * level, and the visited set) are kept as sorted runs, each stored as the
+ * deltas between consecutive states in a variable-length byte code. A
+ * round streams its frontier runs, spills the neighbours to new sorted
+ * runs whenever memoryBudget is full, then merges those runs and
+ * removes every state already in a visited run with one streaming pass.
+ * The states left over are new. Their sorted stream becomes a new visited run and
+ * is split into the next round's frontier and the runs of higher levels.
+ *
+ * Returns the same barrier as computeEnergyBarrier, or -1 if c_target is
+ * not reachable. Throws std::runtime_error if a scratch file cannot be
+ * created or written, or if config.checkpointDirectory already holds a
+ * checkpoint: starting over would delete it, so it must be resumed with
+ * resumeEnergyBarrierExternal or removed by the caller first.
+ */
+int computeEnergyBarrierExternal(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                 const ExternalSearchConfig& config = ExternalSearchConfig());
+int computeEnergyBarrierExternal(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                 const ExternalSearchConfig& config = ExternalSearchConfig());
+
+/*
+ * Continue a computeEnergyBarrierExternal search that was interrupted
+ * (killed, preempted, out of disk) from the checkpoint in
+ * config.checkpointDirectory, with the same H and c_target. Rounds after
+ * the checkpoint are redone, so the result is the one the uninterrupted
+ * search would have returned. Checkpointing continues with config.
+ *
+ * A checkpoint only indexes the run files, which the search writes anyway
+ * and never modifies, so recording one costs a few kilobytes and an fsync.
+ * Files it refers to are kept until the next checkpoint replaces it.
+ *
+ * Throws std::runtime_error if there is no readable checkpoint and
+ * std::invalid_argument if it was written for a different H or c_target.
+ *
+ * Note: computeEnergyBarrierExternal refuses a checkpointDirectory that
+ * holds a checkpoint rather than overwriting it; to abandon an
+ * interrupted search, delete its checkpoint and run<N> files yourself.
+ */
+int resumeEnergyBarrierExternal(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                const ExternalSearchConfig& config);
+int resumeEnergyBarrierExternal(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                const ExternalSearchConfig& config);
+
+// Whether checkpointDirectory holds a checkpoint to resume from
+bool externalCheckpointExists(const std::string& checkpointDirectory);
+
+#endif // ENERGY_BARRIER_EXTERNAL_HPP
@@ -0,0 +1,29 @@
+#ifndef ENERGY_BARRIER_PARALLEL_HPP
+#define ENERGY_BARRIER_PARALLEL_HPP
+
+#include <vector>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Multi-threaded energy barrier from 0 to c_target, for a single search
+ * too large for one core.
+ *
+ * The flood is level synchronous: all states reachable with path peak P
+ * are expanded before any state of peak P + 1. Inside a level the states
+ * whose energy is <= P are expanded breadth first, one round at a time,
+ * each round split over the OpenMP threads. A new neighbour y found at
+ * level P has peak max(P, E(y)) whichever thread finds it first, so the
+ * set of discovered states, and the result, do not depend on the thread
+ * count or on scheduling. Threads share one visited set (atomic bits for
+ * small n, a sharded hash set otherwise) and collect their new states in
+ * private buffers that are merged between rounds.
+ *
+ * threads <= 0 uses the OpenMP default. Same result as
+ * computeEnergyBarrier; -1 if c_target is not reachable.
+ */
+int computeEnergyBarrierParallel(const ParityCheckMatrix& H, const std::vector<int>& c_target,
+                                 int threads = 0);
+int computeEnergyBarrierParallel(const std::vector<std::vector<int>>& H, const std::vector<int>& c_target,
+                                 int threads = 0);
+
+#endif // ENERGY_BARRIER_PARALLEL_HPP
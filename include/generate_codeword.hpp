@@ -6,6 +6,8 @@
 #include <tuple>
 #include <algorithm>
 #include <string>
+#include "parity_check_matrix.hpp"
+#include "search_limits.hpp"
 
 using namespace std;
 
@@ -26,6 +28,15 @@ gaussianEliminationGF2(const vector<vector<int>>& H_in);
  *   Output: A vector of binary strings, each representing one codeword in the null space of H.
  */
 vector<string> computeAllCodewordsGF2(const vector<vector<int>>& H);
+vector<string> computeAllCodewordsGF2(const ParityCheckMatrix& H);
+
+/*
+ * Enumeration under SearchLimits, one unit of work per codeword. If a
+ * limit expires the codewords listed so far are returned (sorted) and
+ * status says which limit stopped it; Complete means the list is full.
+ */
+vector<string> computeAllCodewordsGF2(const ParityCheckMatrix& H, const SearchLimits& limits,
+                                      SearchStatus& status);
 
 /* 
  * Compute the rank of a matrix over GF(2)
@@ -34,12 +45,16 @@ vector<string> computeAllCodewordsGF2(const vector<vector<int>>& H);
 */
 int computeRankGF2(vector<vector<int>>& mat);
 
+// Sparse overload; mat is left unchanged
+int computeRankGF2(const ParityCheckMatrix& mat);
+
 /*
  * Find a single non-trivial codeword in the null space of H
  * Input: H is an ℓ x n parity-check matrix over GF(2)
  * Output: A vector representing a non-zero codeword, or empty vector if none exists
  */
 vector<int> findSingleCodeword(const vector<vector<int>>& H);
+vector<int> findSingleCodeword(const ParityCheckMatrix& H);
 
 /*
  * Compute the Hamming weight (number of 1s) of a binary string
@@ -54,6 +69,14 @@ int hammingWeight(const string& s);
  * - Returns -1 if the code contains only the zero codeword
  */
 int computeMinimumDistance(const vector<vector<int>>& H);
+int computeMinimumDistance(const ParityCheckMatrix& H);
+
+/*
+ * Minimum distance over the codewords enumerated within limits. When
+ * status is not Complete the result is only an upper bound on d (the
+ * lightest nonzero codeword seen), or -1 if none was reached.
+ */
+int computeMinimumDistance(const ParityCheckMatrix& H, const SearchLimits& limits, SearchStatus& status);
 
 /*
  * Generate a random m×n parity-check matrix with weight constraints
@@ -65,6 +88,12 @@ int computeMinimumDistance(const vector<vector<int>>& H);
  */
 vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w);
 
+/*
+ * Same distribution as generateRandomParityCheckMatrix, returned in sparse
+ * form without ever building the dense m×n matrix.
+ */
+ParityCheckMatrix generateRandomSparseParityCheckMatrix(int m, int n, int w);
+
 /*
  * Verify that a matrix satisfies the weight constraints
  * Parameters:
@@ -73,5 +102,6 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w);
  * Returns: true if matrix satisfies constraints, false otherwise
  */
 bool verifyMatrixConstraints(const vector<vector<int>>& H, int w);
+bool verifyMatrixConstraints(const ParityCheckMatrix& H, int w);
 
 #endif // GENERATE_CODEWORD_HPP
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef GF2_BATCH_HPP
+#define GF2_BATCH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "gf2_packed.hpp"
+
+/*
+ * Number of states evaluated together by one pass of the bit-sliced
+ * batch kernel: 512 with AVX-512, 256 with AVX2, 64 on the portable
+ * scalar path, following the level selected in cpu_dispatch.hpp.
+ * Batches that are a multiple of this size use every lane.
+ */
+int energyBatchLanes();
+
+/*
+ * Evaluate E(x) for a batch of states in one call.
+ *
+ * The states are transposed into bit-sliced form (slice c holds bit c of
+ * every state in the block, one state per lane), each row of H becomes an
+ * XOR of the slices of its columns, and the violated checks are summed per
+ * lane with a bit-sliced ripple counter. The cost per row is shared by all
+ * lanes of the block instead of being paid once per state.
+ *
+ * Parameters:
+ * PH - packed parity-check matrix (ℓ x n)
+ * states - count packed states stored back to back, PH.wordsPerRow words each
+ * count - number of states
+ * energies - output array of count energies
+ */
+void energyOfStatesBatch(const PackedMatrix& PH, const uint64_t* states,
+                         std::size_t count, int* energies);
+
+// Convenience overload for a vector of packed states
+std::vector<int> energyOfStatesBatch(const PackedMatrix& PH,
+                                     const std::vector<PackedState>& states);
+
+#endif // GF2_BATCH_HPP
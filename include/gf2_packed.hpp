@@ -0,0 +1,155 @@
+#ifndef GF2_PACKED_HPP
+#define GF2_PACKED_HPP
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * Bit-packed GF(2) vector: bit c lives in word c / 64 at position c % 64.
+ * Unused high bits of the last word are always kept at zero.
+ */
+using PackedState = std::vector<uint64_t>;
+
+/*
+ * Fixed-width packed vector of W words (up to 64*W bits). Used by the
+ * width-specialized search so that copies, comparisons and hashing are
+ * unrolled word operations with no heap allocation.
+ */
+template<int W>
+using FixedState = std::array<uint64_t, W>;
+
+// Word-wise hash for FixedState (multiply/xorshift mix per word)
+template<int W>
+struct FixedStateHash {
+    std::size_t operator()(const FixedState<W>& x) const {
+        uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for(int w = 0; w < W; w++) {
+            h ^= x[w] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 31;
+        }
+        return (std::size_t)h;
+    }
+};
+
+// Widest FixedState the searches are instantiated for
+constexpr int maxFixedStateBits = 1024;
+
+/*
+ * Call f(std::integral_constant<int, W>()) with the smallest width the
+ * searches are instantiated for (W = 1, 2, 4, 8, 16 words) that holds
+ * 'bits' bits. Throws std::invalid_argument naming caller above
+ * maxFixedStateBits.
+ */
+template<class F>
+inline auto withStateWidth(int bits, const char* caller, F&& f) {
+    if(bits <= 64)   return f(std::integral_constant<int, 1>());
+    if(bits <= 128)  return f(std::integral_constant<int, 2>());
+    if(bits <= 256)  return f(std::integral_constant<int, 4>());
+    if(bits <= 512)  return f(std::integral_constant<int, 8>());
+    if(bits <= maxFixedStateBits) return f(std::integral_constant<int, 16>());
+    throw std::invalid_argument(std::string(caller) + ": codes with more than 1024 bits or checks are not supported");
+}
+
+/*
+ * Bit-packed GF(2) matrix (rows x cols).
+ * Row r occupies wordsPerRow consecutive words of data, using the same
+ * bit layout as PackedState, so a row can be ANDed directly with a state.
+ */
+struct PackedMatrix {
+    int rows = 0;
+    int cols = 0;
+    int wordsPerRow = 0;
+    std::vector<uint64_t> data;
+
+    uint64_t* row(int r) { return data.data() + (std::size_t)r * wordsPerRow; }
+    const uint64_t* row(int r) const { return data.data() + (std::size_t)r * wordsPerRow; }
+
+    int get(int r, int c) const { return (int)((row(r)[c >> 6] >> (c & 63)) & 1); }
+    void set(int r, int c) { row(r)[c >> 6] |= (uint64_t)1 << (c & 63); }
+};
+
+// Number of 64-bit words needed to hold nbits bits
+inline int wordsForBits(int nbits) {
+    return (nbits + 63) / 64;
+}
+
+// Flip bit c of a packed word array
+inline void flipBit(uint64_t* x, int c) {
+    x[c >> 6] ^= (uint64_t)1 << (c & 63);
+}
+
+// Read bit c of a packed word array
+inline int getBit(const uint64_t* x, int c) {
+    return (int)((x[c >> 6] >> (c & 63)) & 1);
+}
+
+/*
+ * Conversion shims between the dense vector<int> representation used by
+ * the public APIs and the packed representation used by the kernels.
+ */
+PackedMatrix packMatrix(const std::vector<std::vector<int>>& H);
+std::vector<std::vector<int>> unpackMatrix(const PackedMatrix& PH);
+PackedState packState(const std::vector<int>& x);
+std::vector<int> unpackState(const PackedState& px, int n);
+
+/*
+ * Energy kernel: E(x) = Hamming weight of H*x^T over GF(2).
+ * Each syndrome bit is popcount(row & x) & 1; the AND of every word of a
+ * row is XOR-folded first so one popcount is spent per row.
+ * x must hold at least PH.wordsPerRow words.
+ */
+int energyOfStatePacked(const PackedMatrix& PH, const uint64_t* x);
+int energyOfStatePacked(const PackedMatrix& PH, const PackedState& x);
+
+/*
+ * Packed syndrome s = H*x^T over GF(2), one bit per row of H.
+ * Returns wordsForBits(PH.rows) words; E(x) is the popcount of the result.
+ */
+PackedState syndromeOfStatePacked(const PackedMatrix& PH, const uint64_t* x);
+
+/*
+ * Column adjacency of H: checks[c] lists the rows r with H[r][c] = 1.
+ * Flipping bit c of x flips exactly the syndrome bits in checks[c].
+ */
+std::vector<std::vector<int>> columnChecks(const PackedMatrix& PH);
+
+/*
+ * Energy change caused by flipping one bit whose checks are 'checks'
+ * (any range of row indices, e.g. a columnChecks entry or a CSC column),
+ * given the current packed syndrome: each satisfied check becomes
+ * violated (+1) and each violated check becomes satisfied (-1).
+ */
+template<class Checks>
+inline int flipEnergyDelta(const Checks& checks, const uint64_t* syndrome) {
+    int delta = 0;
+    for(int r : checks) {
+        delta += getBit(syndrome, r) ? -1 : 1;
+    }
+    return delta;
+}
+
+/*
+ * Gaussian elimination over GF(2) on a packed matrix.
+ * Returns a tuple: (RREF of PH, pivotCols, rank).
+ * Row operations XOR whole words, so each elimination step costs
+ * wordsPerRow word operations instead of cols int operations.
+ * The energy, syndrome and elimination kernels run at the instruction-set
+ * level chosen at startup (see cpu_dispatch.hpp).
+ */
+std::tuple<PackedMatrix, std::vector<int>, int>
+gaussianEliminationGF2Packed(const PackedMatrix& PH);
+
+/*
+ * Write the first n bits of x as '0'/'1' characters to out (no terminator).
+ * Used by the codeword enumeration to produce its string output.
+ */
+void packedToBitString(const uint64_t* x, int n, char* out);
+
+#endif // GF2_PACKED_HPP
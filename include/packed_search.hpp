@@ -0,0 +1,102 @@
+#ifndef PACKED_SEARCH_HPP
+#define PACKED_SEARCH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include "gf2_packed.hpp"
+#include "search_structures.hpp"
+
+/*
+ * Barrier flood over states of run-time width, for codes beyond the
+ * FixedState instantiations (more than 1024 bits or checks). Same search
+ * as the fixed-width engine in energy_barrier.cpp: states are expanded in
+ * order of nondecreasing path peak from a monotone bucket queue, so the
+ * first discovery of a state is final.
+ *
+ * Each arena record holds the n-bit state, then the ℓ-bit syndrome, then
+ * the energy, with the state and syndrome each rounded up to whole words
+ * on their own. Header-only because it is templated on the code
+ * representation.
+ *
+ * Code describes H through its columns and never needs it expanded:
+ *   int cols() const, int rows() const
+ *   template<class F> void forEachCheck(int bit, F f) const
+ *       calls f(r) for every check r of column 'bit'
+ * canonicalize(uint64_t* x) may replace a new state by a representative of
+ * the same energy class (e.g. under a symmetry that fixes the target) and
+ * returns true if it changed x; its syndrome is then recomputed.
+ *
+ * Returns:
+ * The barrier from 0 to target, or -1 if the target is not reached by a
+ * path that stays below upperBound
+ */
+template<class Code, class Canonicalize>
+int packedBarrierSearch(const Code& code, const PackedState& target, int upperBound,
+                        Canonicalize&& canonicalize) {
+    const int n = code.cols();
+    const std::size_t sw = wordsForBits(n), rw = wordsForBits(code.rows());
+    const std::size_t stride = sw + rw + 1;
+
+    WordRecordArena arena(stride);
+    MonotoneBucketQueue<std::size_t> pq(0);
+    PackedPeakTable<uint8_t> visited((int)sw);
+    std::vector<uint64_t> next(stride);
+
+    // Start from the zero state, whose syndrome and energy are zero
+    pq.push(0, arena.add());
+    visited.insertOrImprove(arena[0], 0);
+
+    while(!pq.empty()) {
+        int currPeak = pq.topKey();
+        const uint64_t* curr = arena[pq.pop()];
+        const uint64_t* syndrome = curr + sw;
+        int energy = (int)curr[sw + rw];
+
+        for(int i = 0; i < n; i++) {
+            int eNext = energy;
+            code.forEachCheck(i, [&](int r) { eNext += getBit(syndrome, r) ? -1 : 1; });
+            int nextPeak = std::max(currPeak, eNext);
+            if(nextPeak >= upperBound) continue;
+
+            std::copy(curr, curr + sw, next.data());
+            flipBit(next.data(), i);
+            bool moved = canonicalize(next.data());
+
+            // Only membership is stored: the first discovery is final
+            if(!visited.insertOrImprove(next.data(), 0)) continue;
+            if(std::equal(next.begin(), next.begin() + sw, target.begin())) return nextPeak;
+
+            uint64_t* nextSyndrome = next.data() + sw;
+            if(moved) {
+                std::fill(nextSyndrome, nextSyndrome + rw, uint64_t(0));
+                for(std::size_t w = 0; w < sw; w++) {
+                    for(uint64_t bits = next[w]; bits; bits &= bits - 1) {
+                        code.forEachCheck(64 * (int)w + __builtin_ctzll(bits),
+                                          [&](int r) { flipBit(nextSyndrome, r); });
+                    }
+                }
+            } else {
+                std::copy(syndrome, syndrome + rw, nextSyndrome);
+                code.forEachCheck(i, [&](int r) { flipBit(nextSyndrome, r); });
+            }
+            next[sw + rw] = (uint64_t)eNext;
+
+            // arena.add() may start a new slab but never moves curr
+            std::size_t index = arena.add();
+            std::copy(next.begin(), next.end(), arena[index]);
+            pq.push(nextPeak, index);
+        }
+    }
+    return -1;
+}
+
+// packedBarrierSearch without symmetry reduction
+template<class Code>
+int packedBarrierSearch(const Code& code, const PackedState& target, int upperBound = INT_MAX) {
+    return packedBarrierSearch(code, target, upperBound, [](uint64_t*) { return false; });
+}
+
+#endif // PACKED_SEARCH_HPP
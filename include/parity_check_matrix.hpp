@@ -0,0 +1,62 @@
+#ifndef PARITY_CHECK_MATRIX_HPP
+#define PARITY_CHECK_MATRIX_HPP
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "gf2_packed.hpp"
+
+/*
+ * Read-only view of a contiguous run of indices (one row of the CSR
+ * arrays or one column of the CSC arrays), usable in range-for loops.
+ */
+struct IndexRange {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+};
+
+/*
+ * Sparse GF(2) parity-check matrix (ℓ x n).
+ *
+ * Only the positions of the ones are stored, both row-wise (CSR: the
+ * columns of each check) and column-wise (CSC: the checks of each bit),
+ * so loops over H cost O(nnz) instead of O(ℓ·n). Indices inside each row
+ * and column are sorted and duplicates cancel (entries are over GF(2)).
+ */
+class ParityCheckMatrix {
+public:
+    ParityCheckMatrix() = default;
+
+    // Build from a list of (row, column) positions of ones
+    ParityCheckMatrix(int rows, int cols, const std::vector<std::pair<int,int>>& entries);
+
+    // Build from a dense 0/1 matrix (ℓ x n)
+    explicit ParityCheckMatrix(const std::vector<std::vector<int>>& H);
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    std::size_t nnz() const { return colIdx.size(); }
+    bool empty() const { return numRows == 0; }
+
+    // Columns of check r (CSR), checks of bit c (CSC)
+    IndexRange row(int r) const { return {colIdx.data() + rowPtr[r], colIdx.data() + rowPtr[r + 1]}; }
+    IndexRange col(int c) const { return {rowIdx.data() + colPtr[c], rowIdx.data() + colPtr[c + 1]}; }
+
+    int rowWeight(int r) const { return rowPtr[r + 1] - rowPtr[r]; }
+    int colWeight(int c) const { return colPtr[c + 1] - colPtr[c]; }
+
+    // Dense and bit-packed copies, for code that still needs them
+    std::vector<std::vector<int>> toDense() const;
+    PackedMatrix toPacked() const;
+
+private:
+    int numRows = 0;
+    int numCols = 0;
+    std::vector<int> rowPtr{0}, colIdx;   // CSR
+    std::vector<int> colPtr{0}, rowIdx;   // CSC
+};
+
+#endif // PARITY_CHECK_MATRIX_HPP
@@ -0,0 +1,99 @@
+#ifndef QUASI_CYCLIC_HPP
+#define QUASI_CYCLIC_HPP
+
+#include <vector>
+#include <cstdint>
+#include "parity_check_matrix.hpp"
+
+/*
+ * Quasi-cyclic parity-check matrix stored as polynomials.
+ *
+ * H is a blockRows x blockCols grid of L x L circulants (L = circulant
+ * size). Block (i, j) is the polynomial sum_e x^e over its exponent list:
+ * row r of the block has ones in columns (r + e) mod L. A plain circulant
+ * code is the 1 x 1 case. Storage is one exponent list per block, so H
+ * costs O(number of nonzero circulant terms) however large L is.
+ *
+ * Shifting every block of a state by the same t (bit c of block j moves
+ * to (c + t) mod L) is an automorphism of every such H.
+ */
+class QuasiCyclicCode {
+public:
+    /*
+     * exponents[i][j] lists the exponents of block (i, j), each in
+     * [0, L); repeated exponents cancel in pairs over GF(2).
+     */
+    QuasiCyclicCode(int circulantSize, const std::vector<std::vector<std::vector<int>>>& exponents);
+
+    /*
+     * Read the circulant blocks of H. Throws std::invalid_argument if H's
+     * dimensions are not multiples of circulantSize or a block is not
+     * circulant.
+     */
+    static QuasiCyclicCode fromParityCheckMatrix(const ParityCheckMatrix& H, int circulantSize);
+
+    int circulantSize() const { return L; }
+    int blockRows() const { return numBlockRows; }
+    int blockCols() const { return numBlockCols; }
+    int rows() const { return numBlockRows * L; }
+    int cols() const { return numBlockCols * L; }
+    const std::vector<int>& exponents(int i, int j) const { return blocks[i * numBlockCols + j]; }
+
+    // Entry (r, c) of H, generated on demand
+    int entry(int r, int c) const;
+
+    /*
+     * f(r) for every check r of column 'bit', read off the exponents:
+     * column c of block j meets row (c - e) mod L of block i for every
+     * term x^e of block (i, j). Lets packedBarrierSearch walk H unexpanded.
+     */
+    template<class F>
+    void forEachCheck(int bit, F f) const {
+        int j = bit / L, c = bit % L;
+        for(int i = 0; i < numBlockRows; i++) {
+            for(int e : exponents(i, j)) f(i * L + (c - e + L) % L);
+        }
+    }
+
+    ParityCheckMatrix toParityCheckMatrix() const;
+    std::vector<std::vector<int>> toDense() const;
+
+    /*
+     * E(x) for a packed n-bit state (gf2_packed.hpp layout). The syndrome
+     * of block row i is the XOR over its terms x^e of block j of x rotated
+     * by e, done with word shifts on the packed state; only one block of
+     * syndrome (L bits) is held at a time and H is never expanded.
+     */
+    int energy(const uint64_t* x) const;
+    int energy(const std::vector<int>& x) const;
+
+    // x with every block rotated by t
+    std::vector<int> shiftState(const std::vector<int>& x, int t) const;
+
+    // Packed form, t in [0, L): y (cols() bits, overwritten) = x shifted
+    void shiftState(const uint64_t* x, int t, uint64_t* y) const;
+
+    // The shifts t in [0, L) with shiftState(x, t) == x (always contains 0)
+    std::vector<int> invariantShifts(const std::vector<int>& x) const;
+
+    // Column permutation of shiftState(., t), perm[c] = image of column c
+    std::vector<int> shiftPermutation(int t) const;
+
+private:
+    int L;
+    int numBlockRows;
+    int numBlockCols;
+    std::vector<std::vector<int>> blocks;  // blocks[i * numBlockCols + j]
+};
+
+/*
+ * Energy barrier from 0 to c_target on a quasi-cyclic code, searching one
+ * representative per orbit of the block shifts that fix c_target (all L
+ * shifts when c_target is rotation invariant). The flood
+ * (packed_search.hpp) takes neighbour energies from the circulant
+ * exponents through forEachCheck, so H is never expanded, and its states
+ * have run-time width, so the length is not capped at 1024 bits.
+ */
+int computeEnergyBarrierQuasiCyclic(const QuasiCyclicCode& code, const std::vector<int>& c_target);
+
+#endif // QUASI_CYCLIC_HPP
@@ -0,0 +1,99 @@
+#ifndef SEARCH_LIMITS_HPP
+#define SEARCH_LIMITS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+/*
+ * Limits a search checks while it runs, so a runaway call gives its core
+ * back instead of being abandoned after the fact.
+ *
+ * deadline      - wall-clock time (steady clock) at which to stop
+ * maxExpansions - work budget: states expanded (or codewords listed)
+ * cancel        - optional flag another thread sets to stop the search
+ *
+ * A default-constructed SearchLimits never stops anything.
+ */
+struct SearchLimits {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    std::size_t maxExpansions = std::numeric_limits<std::size_t>::max();
+    const std::atomic<bool>* cancel = nullptr;
+
+    // Limits with a deadline 'seconds' from now
+    static SearchLimits withTimeout(double seconds) {
+        SearchLimits limits;
+        limits.deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+        return limits;
+    }
+};
+
+// Why a limited search returned
+enum class SearchStatus { Complete, DeadlineReached, BudgetExhausted, Cancelled };
+
+inline const char* searchStatusName(SearchStatus status) {
+    switch(status) {
+        case SearchStatus::Complete:        return "complete";
+        case SearchStatus::DeadlineReached: return "deadline reached";
+        case SearchStatus::BudgetExhausted: return "budget exhausted";
+        case SearchStatus::Cancelled:       return "cancelled";
+    }
+    return "unknown";
+}
+
+/*
+ * Outcome of a limited barrier query. The true barrier always lies in
+ * [lowerBound, upperBound] (upperBound = -1: no upper bound known), and
+ * barrier holds it once it is known exactly (else -1). Complete means the
+ * query ran to the end; otherwise the bounds are what the search had
+ * established when it stopped.
+ */
+struct BarrierResult {
+    SearchStatus status = SearchStatus::Complete;
+    int barrier = -1;
+    int lowerBound = 0;
+    int upperBound = -1;
+    std::size_t statesExplored = 0;
+
+    bool complete() const { return status == SearchStatus::Complete; }
+};
+
+/*
+ * Counts the work of one search against its SearchLimits. The search
+ * calls expired() once per unit of work and stops when it returns true.
+ * The cancel flag is read on every call and the clock every 16 calls,
+ * so the overhead stays negligible next to a state expansion.
+ */
+class LimitTracker {
+public:
+    explicit LimitTracker(const SearchLimits& limits) : limits(limits) {}
+
+    bool expired() {
+        if(stopped != SearchStatus::Complete) return true;
+        if(limits.cancel && limits.cancel->load(std::memory_order_relaxed)) {
+            stopped = SearchStatus::Cancelled;
+        } else if(count >= limits.maxExpansions) {
+            stopped = SearchStatus::BudgetExhausted;
+        } else if((count & 15) == 0 && std::chrono::steady_clock::now() >= limits.deadline) {
+            stopped = SearchStatus::DeadlineReached;
+        }
+        if(stopped != SearchStatus::Complete) return true;
+        count++;
+        return false;
+    }
+
+    // Complete until a limit has been hit
+    SearchStatus status() const { return stopped; }
+
+    // Units of work done
+    std::size_t expansions() const { return count; }
+
+private:
+    SearchLimits limits;
+    SearchStatus stopped = SearchStatus::Complete;
+    std::size_t count = 0;
+};
+
+#endif // SEARCH_LIMITS_HPP
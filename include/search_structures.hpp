@@ -0,0 +1,499 @@
+#ifndef SEARCH_STRUCTURES_HPP
+#define SEARCH_STRUCTURES_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <mutex>
+
+/*
+ * Data structures shared by the energy-barrier search engines.
+ * Header-only because they are templated on the stored item type.
+ */
+
+/*
+ * Monotone bucket queue for small integer keys in [0, maxKey].
+ *
+ * The barrier search pushes entries keyed by the path peak, and a
+ * neighbour's peak is never below the peak of the state being expanded,
+ * so keys never drop below the current minimum. One bucket per key then
+ * gives O(1) push and pop. Items inside a bucket come out LIFO (depth
+ * first within a level, smallest working set) or FIFO.
+ *
+ * Pushing a key below the current minimum is still handled correctly
+ * (the scan position moves back), it just loses the O(1) guarantee.
+ */
+template<class T>
+class MonotoneBucketQueue {
+public:
+    explicit MonotoneBucketQueue(int maxKey, bool lifo = true)
+        : buckets(maxKey + 1), heads(maxKey + 1, 0), lifoOrder(lifo) {}
+
+    void push(int key, T item) {
+        if(key >= (int)buckets.size()) {
+            buckets.resize(key + 1);
+            heads.resize(key + 1, 0);
+        }
+        if(key < current) current = key;
+        buckets[key].push_back(std::move(item));
+        count++;
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    // Smallest key present; the queue must not be empty
+    int topKey() {
+        advance();
+        return current;
+    }
+
+    // Remove and return an item with the smallest key
+    T pop() {
+        advance();
+        std::vector<T>& bucket = buckets[current];
+        T item;
+        if(lifoOrder) {
+            item = std::move(bucket.back());
+            bucket.pop_back();
+        } else {
+            item = std::move(bucket[heads[current]++]);
+            if(heads[current] == bucket.size()) {
+                bucket.clear();
+                heads[current] = 0;
+            }
+        }
+        count--;
+        return item;
+    }
+
+    // Remove and return every item waiting at key, e.g. to expand a whole
+    // peak level at once
+    std::vector<T> takeBucket(int key) {
+        std::vector<T> items;
+        if(key >= (int)buckets.size()) return items;
+        std::vector<T>& bucket = buckets[key];
+        items.assign(std::make_move_iterator(bucket.begin() + heads[key]),
+                     std::make_move_iterator(bucket.end()));
+        bucket.clear();
+        heads[key] = 0;
+        count -= items.size();
+        return items;
+    }
+
+    void clear() {
+        for(auto& b : buckets) b.clear();
+        std::fill(heads.begin(), heads.end(), 0);
+        current = 0;
+        count = 0;
+    }
+
+private:
+    // Move current to the first non-empty bucket
+    void advance() {
+        while(heads[current] == buckets[current].size()) current++;
+    }
+
+    std::vector<std::vector<T>> buckets;
+    std::vector<std::size_t> heads;
+    bool lifoOrder;
+    int current = 0;
+    std::size_t count = 0;
+};
+
+/*
+ * Open-addressing visited table for the barrier searches, keyed by packed
+ * state words (see gf2_packed.hpp) with the best known peak stored inline.
+ *
+ * Keys live back to back in one flat word array and peaks in a parallel
+ * array of Peak (one byte by default), so a lookup touches two contiguous
+ * slots and never allocates. Linear probing over a power-of-two capacity,
+ * grown at half load. The largest Peak value marks an empty slot, so
+ * stored peaks must be below std::numeric_limits<Peak>::max().
+ *
+ * W > 0 fixes the key width at compile time; W = 0 takes it at run time.
+ */
+template<class Peak = uint8_t, int W = 0>
+class PackedPeakTable {
+public:
+    static constexpr Peak EMPTY = std::numeric_limits<Peak>::max();
+
+    explicit PackedPeakTable(int wordsPerKey = W, std::size_t expected = 1024)
+        : words(W > 0 ? W : wordsPerKey) {
+        std::size_t cap = 16;
+        while(cap < 2 * expected) cap <<= 1;
+        allocate(cap);
+    }
+
+    /*
+     * Record 'peak' for key unless a peak <= 'peak' is already stored.
+     * Returns true if the key was new or its peak improved; a single probe
+     * sequence serves both the lookup and the update.
+     */
+    bool insertOrImprove(const uint64_t* key, Peak peak) {
+        if(2 * (count + 1) > capacity()) allocate(2 * capacity());
+        std::size_t slot = locate(key);
+        if(peaks[slot] == EMPTY) {
+            copyKey(slot, key);
+            peaks[slot] = peak;
+            count++;
+            return true;
+        }
+        if(peak < peaks[slot]) {
+            peaks[slot] = peak;
+            return true;
+        }
+        return false;
+    }
+
+    // Stored peak of key, or -1 if key has not been seen
+    int find(const uint64_t* key) const {
+        std::size_t slot = locate(key);
+        return peaks[slot] == EMPTY ? -1 : (int)peaks[slot];
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return peaks.size(); }
+    std::size_t memoryBytes() const {
+        return keys.size() * sizeof(uint64_t) + peaks.size() * sizeof(Peak);
+    }
+
+    void clear() {
+        std::fill(peaks.begin(), peaks.end(), EMPTY);
+        count = 0;
+    }
+
+private:
+    int wordCount() const { return W > 0 ? W : words; }
+
+    static uint64_t mix(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    std::size_t hashKey(const uint64_t* key) const {
+        uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for(int w = 0; w < wordCount(); w++) h = mix(h ^ key[w]);
+        return (std::size_t)h;
+    }
+
+    bool keyEquals(std::size_t slot, const uint64_t* key) const {
+        const uint64_t* stored = &keys[slot * wordCount()];
+        for(int w = 0; w < wordCount(); w++) {
+            if(stored[w] != key[w]) return false;
+        }
+        return true;
+    }
+
+    void copyKey(std::size_t slot, const uint64_t* key) {
+        std::copy(key, key + wordCount(), &keys[slot * wordCount()]);
+    }
+
+    // Slot holding key, or the empty slot where it would be inserted
+    std::size_t locate(const uint64_t* key) const {
+        std::size_t mask = capacity() - 1;
+        std::size_t slot = hashKey(key) & mask;
+        while(peaks[slot] != EMPTY && !keyEquals(slot, key)) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    // Resize to newCapacity slots and reinsert the current entries
+    void allocate(std::size_t newCapacity) {
+        std::vector<uint64_t> oldKeys;
+        std::vector<Peak> oldPeaks;
+        oldKeys.swap(keys);
+        oldPeaks.swap(peaks);
+        keys.assign(newCapacity * wordCount(), 0);
+        peaks.assign(newCapacity, EMPTY);
+        for(std::size_t s = 0; s < oldPeaks.size(); s++) {
+            if(oldPeaks[s] == EMPTY) continue;
+            const uint64_t* key = &oldKeys[s * wordCount()];
+            std::size_t slot = locate(key);
+            copyKey(slot, key);
+            peaks[slot] = oldPeaks[s];
+        }
+    }
+
+    int words;
+    std::vector<uint64_t> keys;
+    std::vector<Peak> peaks;
+    std::size_t count = 0;
+};
+
+/*
+ * Direct-indexed visited array over the whole configuration space of an
+ * n-bit code, n <= 64: the state with packed word x is slot x, so there
+ * is no hashing and no key storage. Same interface as PackedPeakTable.
+ *
+ * Slots hold peak + 1 (0 = unseen). The array comes from calloc, which
+ * hands out lazily zeroed pages for large sizes, so a search only pays
+ * for the part of the hypercube it actually touches.
+ */
+template<class Peak = uint8_t>
+class DensePeakArray {
+public:
+    static constexpr Peak EMPTY = 0;
+
+    explicit DensePeakArray(int n)
+        : slots(std::size_t(1) << n),
+          peaks(static_cast<Peak*>(std::calloc(std::size_t(1) << n, sizeof(Peak)))) {
+        if(!peaks) throw std::bad_alloc();
+    }
+
+    // Bytes a DensePeakArray for n-bit states would occupy
+    static std::size_t bytesFor(int n) { return (std::size_t(1) << n) * sizeof(Peak); }
+
+    bool insertOrImprove(const uint64_t* key, Peak peak) {
+        Peak& slot = peaks.get()[key[0]];
+        if(slot == EMPTY) {
+            slot = peak + 1;
+            count++;
+            return true;
+        }
+        if(peak + 1 < slot) {
+            slot = peak + 1;
+            return true;
+        }
+        return false;
+    }
+
+    int find(const uint64_t* key) const {
+        Peak slot = peaks.get()[key[0]];
+        return slot == EMPTY ? -1 : (int)slot - 1;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return slots; }
+    std::size_t memoryBytes() const { return slots * sizeof(Peak); }
+
+    void clear() {
+        std::fill(peaks.get(), peaks.get() + slots, EMPTY);
+        count = 0;
+    }
+
+private:
+    struct FreeDeleter {
+        void operator()(Peak* p) const { std::free(p); }
+    };
+
+    std::size_t slots;
+    std::unique_ptr<Peak, FreeDeleter> peaks;
+    std::size_t count = 0;
+};
+
+/*
+ * Append-only arena of search states stored in fixed-size slabs. Items
+ * are addressed by their index, so a priority queue can hold plain
+ * indices, and growing never moves existing items. reset() forgets every
+ * item but keeps the slabs, so an arena reused for the next search does
+ * not go back to the allocator until it outgrows its previous peak.
+ */
+template<class T, std::size_t SlabSize = 4096>
+class SlabArena {
+public:
+    // Reserve a default-constructed item and return its index
+    std::size_t add() {
+        if(count == slabs.size() * SlabSize) {
+            slabs.emplace_back(new T[SlabSize]);
+        }
+        return count++;
+    }
+
+    std::size_t add(const T& item) {
+        std::size_t index = add();
+        (*this)[index] = item;
+        return index;
+    }
+
+    T& operator[](std::size_t index) { return slabs[index / SlabSize][index % SlabSize]; }
+    const T& operator[](std::size_t index) const { return slabs[index / SlabSize][index % SlabSize]; }
+
+    std::size_t size() const { return count; }
+    std::size_t memoryBytes() const { return slabs.size() * SlabSize * sizeof(T); }
+
+    // Drop every item, keeping the slabs for reuse
+    void reset() { count = 0; }
+
+    // Drop every item and return the slabs to the allocator
+    void release() {
+        slabs.clear();
+        slabs.shrink_to_fit();
+        count = 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<T[]>> slabs;
+    std::size_t count = 0;
+};
+
+/*
+ * SlabArena for records of 'stride' 64-bit words with the stride chosen at
+ * run time, e.g. a packed state followed by its syndrome when the code is
+ * too wide for a FixedState. Records are addressed by index and never
+ * move; operator[] returns a pointer to the record's first word.
+ */
+class WordRecordArena {
+public:
+    explicit WordRecordArena(std::size_t stride, std::size_t recordsPerSlab = 4096)
+        : stride(stride), perSlab(recordsPerSlab) {}
+
+    // Reserve a zero-filled record and return its index
+    std::size_t add() {
+        if(count == slabs.size() * perSlab) {
+            slabs.emplace_back(new uint64_t[stride * perSlab]);
+        }
+        std::fill_n((*this)[count], stride, uint64_t(0));
+        return count++;
+    }
+
+    uint64_t* operator[](std::size_t index) {
+        return slabs[index / perSlab].get() + (index % perSlab) * stride;
+    }
+    const uint64_t* operator[](std::size_t index) const {
+        return slabs[index / perSlab].get() + (index % perSlab) * stride;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t memoryBytes() const { return slabs.size() * perSlab * stride * sizeof(uint64_t); }
+
+private:
+    std::size_t stride;
+    std::size_t perSlab;
+    std::vector<std::unique_ptr<uint64_t[]>> slabs;
+    std::size_t count = 0;
+};
+
+/*
+ * Direct-indexed visited set with one bit per state, for searches that
+ * only need membership (e.g. a fixed energy threshold). Same interface as
+ * DensePeakArray; the peak argument is ignored.
+ */
+class DenseVisitedBits {
+public:
+    explicit DenseVisitedBits(int n)
+        : words(wordsFor(n)),
+          bits(static_cast<uint64_t*>(std::calloc(wordsFor(n), sizeof(uint64_t)))) {
+        if(!bits) throw std::bad_alloc();
+    }
+
+    static std::size_t bytesFor(int n) { return wordsFor(n) * sizeof(uint64_t); }
+
+    // Mark key as visited; true if it was not visited before
+    bool insertOrImprove(const uint64_t* key, int = 0) {
+        uint64_t& word = bits.get()[key[0] >> 6];
+        uint64_t mask = uint64_t(1) << (key[0] & 63);
+        if(word & mask) return false;
+        word |= mask;
+        count++;
+        return true;
+    }
+
+    int find(const uint64_t* key) const {
+        return (bits.get()[key[0] >> 6] >> (key[0] & 63)) & 1 ? 0 : -1;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t memoryBytes() const { return words * sizeof(uint64_t); }
+
+private:
+    static std::size_t wordsFor(int n) { return ((std::size_t(1) << n) + 63) / 64; }
+
+    struct FreeDeleter {
+        void operator()(uint64_t* p) const { std::free(p); }
+    };
+
+    std::size_t words;
+    std::unique_ptr<uint64_t, FreeDeleter> bits;
+    std::size_t count = 0;
+};
+
+/*
+ * Visited set shared by the threads of a parallel search: 2^shardBits
+ * PackedPeakTables, each behind its own mutex, with the shard picked from
+ * the top bits of a separate hash of the key. Threads inserting different
+ * states rarely meet on the same lock, and no table is ever resized
+ * while another thread probes it.
+ */
+template<int W>
+class ShardedVisitedSet {
+public:
+    explicit ShardedVisitedSet(int shardBits = 10)
+        : shift(64 - shardBits), shards(std::size_t(1) << shardBits) {}
+
+    // Mark key as visited; true if it was not visited before
+    bool insert(const uint64_t* key) {
+        Shard& shard = shards[shardOf(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.table.insertOrImprove(key, 0);
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for(const Shard& shard : shards) total += shard.table.size();
+        return total;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        PackedPeakTable<uint8_t, W> table{W, 64};
+    };
+
+    std::size_t shardOf(const uint64_t* key) const {
+        uint64_t h = 0x2545F4914F6CDD1DULL;
+        for(int w = 0; w < W; w++) {
+            h = (h ^ key[w]) * 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 29;
+        }
+        return (std::size_t)(h * 0xBF58476D1CE4E5B9ULL >> shift);
+    }
+
+    int shift;
+    std::vector<Shard> shards;
+};
+
+/*
+ * DenseVisitedBits for concurrent use: the bit of a state is set with an
+ * atomic fetch-or, so exactly one thread sees each state as new.
+ */
+class AtomicVisitedBits {
+public:
+    explicit AtomicVisitedBits(int n)
+        : words(wordsFor(n)),
+          bits(static_cast<uint64_t*>(std::calloc(wordsFor(n), sizeof(uint64_t)))) {
+        if(!bits) throw std::bad_alloc();
+    }
+
+    static std::size_t bytesFor(int n) { return wordsFor(n) * sizeof(uint64_t); }
+
+    bool insert(const uint64_t* key) {
+        uint64_t mask = uint64_t(1) << (key[0] & 63);
+        uint64_t old = __atomic_fetch_or(&bits.get()[key[0] >> 6], mask, __ATOMIC_RELAXED);
+        return !(old & mask);
+    }
+
+    std::size_t memoryBytes() const { return words * sizeof(uint64_t); }
+
+private:
+    static std::size_t wordsFor(int n) { return ((std::size_t(1) << n) + 63) / 64; }
+
+    struct FreeDeleter {
+        void operator()(uint64_t* p) const { std::free(p); }
+    };
+
+    std::size_t words;
+    std::unique_ptr<uint64_t, FreeDeleter> bits;
+};
+
+#endif // SEARCH_STRUCTURES_HPP
@@ -2,6 +2,7 @@
 #define TENSOR_PRODUCT_HPP
 
 #include <vector>
+#include "parity_check_matrix.hpp"
 
 /*
  * Build the tensor product parity-check matrix:
@@ -16,6 +17,14 @@ std::vector<std::vector<int>> buildTensorProductParityCheck(
     const std::vector<std::vector<int>>& H2  // m2 x n2
 );
 
+/*
+ * Sparse overload of buildTensorProductParityCheck, O(nnz) in the result.
+ */
+ParityCheckMatrix buildTensorProductParityCheck(
+    const ParityCheckMatrix& H1, // m1 x n1
+    const ParityCheckMatrix& H2  // m2 x n2
+);
+
 /*
  * Build the tensor product codeword from two codewords c1 and c2.
  * The result is a codeword of length n1 * n2.
@@ -0,0 +1,234 @@
+#include "../include/code_automorphism.hpp"
+#include <vector>
+#include <map>
+#include <set>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+// Colours of the bits (columns) and checks (rows) of the Tanner graph
+struct Colouring {
+    vector<int> col;
+    vector<int> row;
+};
+
+static int distinctColours(const vector<int>& colours) {
+    return (int)set<int>(colours.begin(), colours.end()).size();
+}
+
+/*
+ * Relabel one side of the Tanner graph in A and B together. A node's new
+ * colour is its old colour plus the sorted colours of its neighbours;
+ * signatures are numbered over both colourings, so equal colours mean the
+ * same thing in A and B. Returns false if some colour class has different
+ * sizes in A and B.
+ */
+static bool refineSide(int count, const vector<int>& ownA, const vector<int>& ownB,
+                       const vector<int>& otherA, const vector<int>& otherB,
+                       const function<IndexRange(int)>& neighbours,
+                       vector<int>& outA, vector<int>& outB) {
+    vector<vector<int>> sigA(count), sigB(count);
+    for(int v = 0; v < count; v++) {
+        sigA[v].push_back(ownA[v]);
+        sigB[v].push_back(ownB[v]);
+        for(int u : neighbours(v)) {
+            sigA[v].push_back(otherA[u]);
+            sigB[v].push_back(otherB[u]);
+        }
+        sort(sigA[v].begin() + 1, sigA[v].end());
+        sort(sigB[v].begin() + 1, sigB[v].end());
+    }
+
+    map<vector<int>, int> ids;
+    for(const auto& s : sigA) ids.emplace(s, 0);
+    for(const auto& s : sigB) ids.emplace(s, 0);
+    int next = 0;
+    for(auto& entry : ids) entry.second = next++;
+
+    vector<int> sizeA(next, 0), sizeB(next, 0);
+    for(int v = 0; v < count; v++) {
+        outA[v] = ids[sigA[v]];
+        outB[v] = ids[sigB[v]];
+        sizeA[outA[v]]++;
+        sizeB[outB[v]]++;
+    }
+    return sizeA == sizeB;
+}
+
+// Colour refinement of A and B to a common equitable partition
+static bool refinePair(const ParityCheckMatrix& H, Colouring& A, Colouring& B) {
+    auto rowNbrs = [&](int r) { return H.row(r); };
+    auto colNbrs = [&](int c) { return H.col(c); };
+    int before = distinctColours(A.col) + distinctColours(A.row);
+    while(true) {
+        if(!refineSide(H.rows(), A.row, B.row, A.col, B.col, rowNbrs, A.row, B.row)) return false;
+        if(!refineSide(H.cols(), A.col, B.col, A.row, B.row, colNbrs, A.col, B.col)) return false;
+        int after = distinctColours(A.col) + distinctColours(A.row);
+        if(after == before) return true;
+        before = after;
+    }
+}
+
+// Give column x of A and column y of B the same fresh colour
+static void individualize(Colouring& A, int x, Colouring& B, int y) {
+    int fresh = max(*max_element(A.col.begin(), A.col.end()),
+                    *max_element(B.col.begin(), B.col.end())) + 1;
+    A.col[x] = fresh;
+    B.col[y] = fresh;
+}
+
+// First column colour class with more than one member, or -1
+static int firstNonSingletonCell(const vector<int>& colours) {
+    map<int, int> size;
+    for(int k : colours) size[k]++;
+    for(const auto& entry : size) {
+        if(entry.second > 1) return entry.first;
+    }
+    return -1;
+}
+
+/*
+ * Backtracking search for an automorphism mapping colouring A onto B:
+ * refine, then individualize the smallest column of the first non-trivial
+ * cell of A against each column of the same colour in B.
+ */
+static bool extendAutomorphism(const ParityCheckMatrix& H, Colouring A, Colouring B,
+                               size_t& budget, vector<int>& perm) {
+    if(budget == 0) return false;
+    budget--;
+    if(!refinePair(H, A, B)) return false;
+
+    int n = H.cols();
+    int cell = firstNonSingletonCell(A.col);
+    if(cell < 0) {
+        vector<int> byColour(*max_element(B.col.begin(), B.col.end()) + 1, -1);
+        for(int y = 0; y < n; y++) byColour[B.col[y]] = y;
+        for(int x = 0; x < n; x++) perm[x] = byColour[A.col[x]];
+        return isColumnAutomorphism(H, perm);
+    }
+
+    int x = int(find(A.col.begin(), A.col.end(), cell) - A.col.begin());
+    for(int y = 0; y < n; y++) {
+        if(B.col[y] != cell) continue;
+        Colouring A2 = A, B2 = B;
+        individualize(A2, x, B2, y);
+        if(extendAutomorphism(H, A2, B2, budget, perm)) return true;
+    }
+    return false;
+}
+
+// Orbit of point under the generators that fix every point in 'fixed'
+static vector<char> orbitOf(int point, int n, const vector<vector<int>>& generators,
+                            const vector<int>& fixed) {
+    vector<const vector<int>*> stabilizer;
+    for(const auto& g : generators) {
+        bool fixesAll = true;
+        for(int p : fixed) if(g[p] != p) { fixesAll = false; break; }
+        if(fixesAll) stabilizer.push_back(&g);
+    }
+    vector<char> inOrbit(n, 0);
+    queue<int> q;
+    q.push(point);
+    inOrbit[point] = 1;
+    while(!q.empty()) {
+        int u = q.front();
+        q.pop();
+        for(const auto* g : stabilizer) {
+            int v = (*g)[u];
+            if(!inOrbit[v]) {
+                inOrbit[v] = 1;
+                q.push(v);
+            }
+        }
+    }
+    return inOrbit;
+}
+
+bool isColumnAutomorphism(const ParityCheckMatrix& H, const vector<int>& perm) {
+    int n = H.cols();
+    if((int)perm.size() != n) return false;
+    vector<char> seen(n, 0);
+    for(int p : perm) {
+        if(p < 0 || p >= n || seen[p]) return false;
+        seen[p] = 1;
+    }
+
+    vector<vector<int>> original, mapped;
+    for(int r = 0; r < H.rows(); r++) {
+        original.emplace_back(H.row(r).begin(), H.row(r).end());
+        vector<int> image;
+        for(int c : H.row(r)) image.push_back(perm[c]);
+        sort(image.begin(), image.end());
+        mapped.push_back(image);
+    }
+    sort(original.begin(), original.end());
+    sort(mapped.begin(), mapped.end());
+    return original == mapped;
+}
+
+vector<vector<int>> findColumnAutomorphisms(const ParityCheckMatrix& H, const vector<int>& fixedWord,
+                                            size_t maxNodes) {
+    int n = H.cols();
+    if((int)fixedWord.size() != n) {
+        throw invalid_argument("findColumnAutomorphisms: fixedWord length does not match H");
+    }
+    vector<vector<int>> generators;
+    if(n == 0) return generators;
+
+    Colouring base;
+    base.col.resize(n);
+    for(int c = 0; c < n; c++) base.col[c] = fixedWord[c] & 1;
+    base.row.assign(H.rows(), 0);
+    Colouring copy = base;
+    refinePair(H, base, copy);
+
+    size_t budget = maxNodes;
+    vector<int> basePoints;
+    while(budget > 0) {
+        int cell = firstNonSingletonCell(base.col);
+        if(cell < 0) break;
+        int b = int(find(base.col.begin(), base.col.end(), cell) - base.col.begin());
+
+        // Look for b -> j for every j of b's cell not yet in its orbit
+        vector<char> inOrbit = orbitOf(b, n, generators, basePoints);
+        for(int j = 0; j < n && budget > 0; j++) {
+            if(base.col[j] != cell || inOrbit[j]) continue;
+            Colouring A = base, B = base;
+            individualize(A, b, B, j);
+            vector<int> perm(n);
+            if(extendAutomorphism(H, A, B, budget, perm)) {
+                generators.push_back(perm);
+                inOrbit = orbitOf(b, n, generators, basePoints);
+            }
+        }
+
+        // Fix b and continue inside its stabilizer
+        basePoints.push_back(b);
+        Colouring fixedCopy = base;
+        individualize(base, b, fixedCopy, b);
+        refinePair(H, base, fixedCopy);
+    }
+    return generators;
+}
+
+vector<vector<int>> permutationGroupElements(const vector<vector<int>>& generators, int n,
+                                             size_t maxElements) {
+    vector<int> identity(n);
+    for(int c = 0; c < n; c++) identity[c] = c;
+
+    set<vector<int>> seen{identity};
+    vector<vector<int>> elements{identity};
+    for(size_t k = 0; k < elements.size() && elements.size() < maxElements; k++) {
+        for(const auto& g : generators) {
+            vector<int> h(n);
+            for(int c = 0; c < n; c++) h[c] = g[elements[k][c]];
+            if(seen.insert(h).second) {
+                elements.push_back(h);
+                if(elements.size() >= maxElements) break;
+            }
+        }
+    }
+    return elements;
+}
@@ -0,0 +1,121 @@
+#include "../include/code_components.hpp"
+#include "../include/energy_barrier.hpp"
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+using namespace std;
+
+vector<TannerComponent> tannerComponents(const ParityCheckMatrix& H) {
+    int n = H.cols();
+    vector<char> seenCol(n, 0), seenRow(H.rows(), 0);
+    vector<TannerComponent> components;
+    for(int start = 0; start < n; start++) {
+        if(seenCol[start]) continue;
+        TannerComponent comp;
+        queue<int> q;  // bit indices
+        q.push(start);
+        seenCol[start] = 1;
+        while(!q.empty()) {
+            int c = q.front();
+            q.pop();
+            comp.cols.push_back(c);
+            for(int r : H.col(c)) {
+                if(seenRow[r]) continue;
+                seenRow[r] = 1;
+                comp.rows.push_back(r);
+                for(int c2 : H.row(r)) {
+                    if(!seenCol[c2]) {
+                        seenCol[c2] = 1;
+                        q.push(c2);
+                    }
+                }
+            }
+        }
+        sort(comp.cols.begin(), comp.cols.end());
+        sort(comp.rows.begin(), comp.rows.end());
+        components.push_back(comp);
+    }
+    return components;
+}
+
+ParityCheckMatrix subParityCheck(const ParityCheckMatrix& H, const vector<int>& rows,
+                                 const vector<int>& cols) {
+    vector<int> localCol(H.cols(), -1);
+    for(size_t k = 0; k < cols.size(); k++) localCol[cols[k]] = (int)k;
+    vector<pair<int,int>> entries;
+    for(size_t k = 0; k < rows.size(); k++) {
+        for(int c : H.row(rows[k])) {
+            if(localCol[c] >= 0) entries.push_back({(int)k, localCol[c]});
+        }
+    }
+    return ParityCheckMatrix((int)rows.size(), (int)cols.size(), entries);
+}
+
+// One independently solved part: a sub-code and the target restricted to it
+struct BarrierPart {
+    ParityCheckMatrix H;
+    vector<int> target;
+};
+
+static BarrierPart makePart(const ParityCheckMatrix& H, const vector<int>& c_target,
+                            const vector<int>& rows, const vector<int>& cols) {
+    BarrierPart part{subParityCheck(H, rows, cols), vector<int>(cols.size())};
+    for(size_t k = 0; k < cols.size(); k++) part.target[k] = c_target[cols[k]] & 1;
+    return part;
+}
+
+int computeEnergyBarrierDecomposed(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierDecomposed: c_target length does not match H");
+    }
+
+    vector<BarrierPart> parts;
+    vector<int> restRows, restCols;  // components where c_target is not a codeword
+    for(const TannerComponent& comp : tannerComponents(H)) {
+        bool touched = false;
+        for(int c : comp.cols) if(c_target[c] & 1) { touched = true; break; }
+        if(!touched) continue;
+
+        BarrierPart part = makePart(H, c_target, comp.rows, comp.cols);
+        if(energyOfState(part.H, part.target) == 0) {
+            parts.push_back(move(part));
+        } else {
+            restRows.insert(restRows.end(), comp.rows.begin(), comp.rows.end());
+            restCols.insert(restCols.end(), comp.cols.begin(), comp.cols.end());
+        }
+    }
+    if(!restCols.empty()) {
+        sort(restRows.begin(), restRows.end());
+        sort(restCols.begin(), restCols.end());
+        parts.push_back(makePart(H, c_target, restRows, restCols));
+    }
+
+    // Largest parts first so dynamic scheduling balances the threads
+    sort(parts.begin(), parts.end(), [](const BarrierPart& a, const BarrierPart& b) {
+        return a.H.cols() > b.H.cols();
+    });
+
+    int barrier = 0;
+    bool unreachable = false;
+    exception_ptr failure;
+    #pragma omp parallel for schedule(dynamic) reduction(max:barrier) reduction(||:unreachable)
+    for(int k = 0; k < (int)parts.size(); k++) {
+        try {
+            int b = computeEnergyBarrier(parts[k].H, parts[k].target);
+            if(b < 0) unreachable = true;
+            barrier = max(barrier, b);
+        } catch(...) {
+            #pragma omp critical
+            if(!failure) failure = current_exception();
+        }
+    }
+    if(failure) rethrow_exception(failure);
+    if(unreachable) return -1;
+    return barrier;
+}
+
+int computeEnergyBarrierDecomposed(const vector<vector<int>>& H, const vector<int>& c_target) {
+    return computeEnergyBarrierDecomposed(ParityCheckMatrix(H), c_target);
+}
@@ -0,0 +1,169 @@
+#include "../include/code_reordering.hpp"
+#include <vector>
+#include <queue>
+#include <algorithm>
+using namespace std;
+
+/*
+ * The Tanner graph uses node ids 0..n-1 for bits and n..n+ℓ-1 for checks.
+ * Neighbours of a bit are its checks (CSC), of a check its bits (CSR).
+ */
+static vector<int> tannerNeighbours(const ParityCheckMatrix& H, int node) {
+    int n = H.cols();
+    vector<int> nbrs;
+    if(node < n) {
+        for(int r : H.col(node)) nbrs.push_back(n + r);
+    } else {
+        for(int c : H.row(node - n)) nbrs.push_back(c);
+    }
+    return nbrs;
+}
+
+static int tannerDegree(const ParityCheckMatrix& H, int node) {
+    int n = H.cols();
+    return node < n ? H.colWeight(node) : H.rowWeight(node - n);
+}
+
+// BFS levels from 'start' inside its component; returns the last level
+static vector<int> lastBfsLevel(const ParityCheckMatrix& H, int start, int& eccentricity) {
+    int total = H.cols() + H.rows();
+    vector<int> dist(total, -1);
+    vector<int> frontier{start};
+    dist[start] = 0;
+    eccentricity = 0;
+    while(true) {
+        vector<int> next;
+        for(int u : frontier) {
+            for(int v : tannerNeighbours(H, u)) {
+                if(dist[v] < 0) {
+                    dist[v] = dist[u] + 1;
+                    next.push_back(v);
+                }
+            }
+        }
+        if(next.empty()) return frontier;
+        frontier.swap(next);
+        eccentricity++;
+    }
+}
+
+/*
+ * George–Liu heuristic: keep jumping to a minimum-degree node of the last
+ * BFS level while that increases the eccentricity.
+ */
+static int pseudoPeripheralNode(const ParityCheckMatrix& H, int start) {
+    int ecc = 0;
+    vector<int> level = lastBfsLevel(H, start, ecc);
+    while(true) {
+        int candidate = *min_element(level.begin(), level.end(), [&](int a, int b) {
+            return tannerDegree(H, a) < tannerDegree(H, b);
+        });
+        int candEcc = 0;
+        vector<int> candLevel = lastBfsLevel(H, candidate, candEcc);
+        if(candEcc <= ecc) return start;
+        start = candidate;
+        ecc = candEcc;
+        level.swap(candLevel);
+    }
+}
+
+CodeOrdering identityOrdering(int rows, int cols) {
+    CodeOrdering ord;
+    ord.colPerm.resize(cols);
+    ord.rowPerm.resize(rows);
+    for(int c = 0; c < cols; c++) ord.colPerm[c] = c;
+    for(int r = 0; r < rows; r++) ord.rowPerm[r] = r;
+    ord.colInverse = ord.colPerm;
+    ord.rowInverse = ord.rowPerm;
+    return ord;
+}
+
+CodeOrdering reverseCuthillMcKee(const ParityCheckMatrix& H) {
+    int n = H.cols();
+    int total = n + H.rows();
+
+    // Cuthill–McKee over every component, lowest-degree seeds first
+    vector<int> seeds(total);
+    for(int v = 0; v < total; v++) seeds[v] = v;
+    stable_sort(seeds.begin(), seeds.end(), [&](int a, int b) {
+        return tannerDegree(H, a) < tannerDegree(H, b);
+    });
+
+    vector<char> visited(total, 0);
+    vector<int> order;
+    order.reserve(total);
+    for(int seed : seeds) {
+        if(visited[seed]) continue;
+        int root = pseudoPeripheralNode(H, seed);
+
+        queue<int> q;
+        q.push(root);
+        visited[root] = 1;
+        while(!q.empty()) {
+            int u = q.front();
+            q.pop();
+            order.push_back(u);
+
+            vector<int> nbrs;
+            for(int v : tannerNeighbours(H, u)) {
+                if(!visited[v]) nbrs.push_back(v);
+            }
+            stable_sort(nbrs.begin(), nbrs.end(), [&](int a, int b) {
+                return tannerDegree(H, a) < tannerDegree(H, b);
+            });
+            for(int v : nbrs) {
+                visited[v] = 1;
+                q.push(v);
+            }
+        }
+    }
+    reverse(order.begin(), order.end());
+
+    // Split the joint sequence into a column order and a row order
+    CodeOrdering ord;
+    for(int v : order) {
+        if(v < n) ord.colPerm.push_back(v);
+        else ord.rowPerm.push_back(v - n);
+    }
+    ord.colInverse.assign(n, 0);
+    ord.rowInverse.assign(H.rows(), 0);
+    for(int j = 0; j < n; j++) ord.colInverse[ord.colPerm[j]] = j;
+    for(int i = 0; i < H.rows(); i++) ord.rowInverse[ord.rowPerm[i]] = i;
+    return ord;
+}
+
+int parityCheckBandwidth(const ParityCheckMatrix& H) {
+    int band = 0;
+    for(int r = 0; r < H.rows(); r++) {
+        IndexRange cols = H.row(r);
+        if(cols.size() > 1) band = max(band, *(cols.end() - 1) - *cols.begin());
+    }
+    return band;
+}
+
+ParityCheckMatrix permuteParityCheck(const ParityCheckMatrix& H, const CodeOrdering& ord) {
+    vector<pair<int,int>> entries;
+    entries.reserve(H.nnz());
+    for(int r = 0; r < H.rows(); r++) {
+        for(int c : H.row(r)) entries.push_back({ord.rowInverse[r], ord.colInverse[c]});
+    }
+    return ParityCheckMatrix(H.rows(), H.cols(), entries);
+}
+
+vector<int> permuteState(const vector<int>& x, const CodeOrdering& ord) {
+    vector<int> y(x.size());
+    for(size_t j = 0; j < x.size(); j++) y[j] = x[ord.colPerm[j]];
+    return y;
+}
+
+vector<int> unpermuteState(const vector<int>& x, const CodeOrdering& ord) {
+    vector<int> y(x.size());
+    for(size_t j = 0; j < x.size(); j++) y[ord.colPerm[j]] = x[j];
+    return y;
+}
+
+vector<int> unpermuteFlipPath(const vector<int>& path, const CodeOrdering& ord) {
+    vector<int> original(path.size());
+    for(size_t t = 0; t < path.size(); t++) original[t] = ord.colPerm[path[t]];
+    return original;
+}
@@ -0,0 +1,84 @@
+#include "../include/cpu_dispatch.hpp"
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <atomic>
+#include <stdexcept>
+using namespace std;
+
+// -1 until the first query, then the active level
+static atomic<int> activeLevel{-1};
+
+Gf2Isa detectGf2Isa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    bool popcnt = __builtin_cpu_supports("popcnt");
+    bool avx2 = popcnt && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+    bool avx512 = avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    if(avx512) return Gf2Isa::Avx512;
+    if(avx2) return Gf2Isa::Avx2;
+    if(popcnt) return Gf2Isa::Popcnt;
+#endif
+    return Gf2Isa::Generic;
+}
+
+bool gf2IsaSupported(Gf2Isa isa) {
+    return (int)isa <= (int)detectGf2Isa();
+}
+
+string gf2IsaName(Gf2Isa isa) {
+    switch(isa) {
+        case Gf2Isa::Generic: return "generic";
+        case Gf2Isa::Popcnt: return "popcnt";
+        case Gf2Isa::Avx2: return "avx2";
+        case Gf2Isa::Avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+Gf2Isa parseGf2Isa(const string& name) {
+    for(Gf2Isa isa : {Gf2Isa::Generic, Gf2Isa::Popcnt, Gf2Isa::Avx2, Gf2Isa::Avx512}) {
+        if(name == gf2IsaName(isa)) return isa;
+    }
+    throw invalid_argument("unknown GF(2) instruction set: " + name);
+}
+
+/*
+ * Level picked from CPUID, lowered by GF2_ISA if it names a lower one. An
+ * unknown GF2_ISA value is reported on stderr and ignored, so it can never
+ * surface as an exception from inside a kernel call.
+ */
+static Gf2Isa resolveGf2Isa() {
+    Gf2Isa isa = detectGf2Isa();
+    // GF2_ISA may lower the level (never raise it past what the CPU has)
+    if(const char* env = getenv("GF2_ISA")) {
+        try {
+            Gf2Isa requested = parseGf2Isa(env);
+            if((int)requested < (int)isa) isa = requested;
+        } catch(const invalid_argument& e) {
+            cerr << "Warning: " << e.what() << " in GF2_ISA, using " << gf2IsaName(isa) << endl;
+        }
+    }
+    return isa;
+}
+
+Gf2Isa activeGf2Isa() {
+    int level = activeLevel.load(memory_order_relaxed);
+    if(level >= 0) return (Gf2Isa)level;
+
+    Gf2Isa isa = resolveGf2Isa();
+    activeLevel.store((int)isa, memory_order_relaxed);
+    return isa;
+}
+
+// Never read: its initializer resolves the level (and reports a bad
+// GF2_ISA) at static initialization, before any search or OpenMP region
+// could be the first caller of activeGf2Isa(). Do not remove.
+static const bool gf2IsaResolvedAtStartup = (activeGf2Isa(), true);
+
+void forceGf2Isa(Gf2Isa isa) {
+    if(!gf2IsaSupported(isa)) {
+        throw invalid_argument("CPU does not support GF(2) kernels: " + gf2IsaName(isa));
+    }
+    activeLevel.store((int)isa, memory_order_relaxed);
+}
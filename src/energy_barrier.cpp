@@ -1,9 +1,21 @@
 #include <iostream>
 #include <vector>
-#include <queue>
-#include <unordered_map>
 #include <string>
+#include <unordered_map>
 #include <algorithm>
+#include <stdexcept>
+#include <atomic>
+#include <cstdint>
+#include <climits>
+#include <type_traits>
+#include "../include/energy_barrier.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/parity_check_matrix.hpp"
+#include "../include/search_structures.hpp"
+#include "../include/packed_search.hpp"
+#include "../include/generate_codeword.hpp"
+#include "../include/code_automorphism.hpp"
+#include "../include/search_limits.hpp"
 using namespace std;
 
 /*
@@ -28,6 +40,20 @@ int energyOfState(const vector<vector<int>>& H, const vector<int>& x) {
     return countViolated;
 }
 
+/*
+ * Sparse overload: each row contributes the parity of x over its columns,
+ * so the cost is O(nnz) rather than O(ℓ·n).
+ */
+int energyOfState(const ParityCheckMatrix& H, const vector<int>& x) {
+    int countViolated = 0;
+    for(int r = 0; r < H.rows(); r++) {
+        int dot = 0;
+        for(int c : H.row(r)) dot ^= x[c];
+        countViolated += dot & 1;
+    }
+    return countViolated;
+}
+
 /*
  * Compute the minimal energy barrier from the zero codeword (all 0's) 
  * to c_target by single-bit flips. 
@@ -42,7 +68,240 @@ int energyOfState(const vector<vector<int>>& H, const vector<int>& x) {
  * Return: minimal energy barrier as an integer.
  */
 int computeEnergyBarrier(const vector<vector<int>>& H, const vector<int>& c_target) {
+    return computeEnergyBarrier(ParityCheckMatrix(H), c_target);
+}
+
+// A search state with its syndrome and energy, stored in a SlabArena
+template<int W>
+struct SearchNode {
+    FixedState<W> x;
+    FixedState<W> syndrome;
+    int energy;
+};
+
+/*
+ * Per-thread search storage, reset in bulk at the start of every search.
+ * Callers that run one search after another on the same thread (e.g. the
+ * OpenMP workers of ebc_tp_multi_simu) reuse the slabs and buckets of the
+ * previous search instead of going back to the allocator.
+ */
+template<int W>
+static SlabArena<SearchNode<W>>& threadSearchArena() {
+    thread_local SlabArena<SearchNode<W>> arena;
+    return arena;
+}
+
+static MonotoneBucketQueue<uint32_t>& threadSearchQueue() {
+    thread_local MonotoneBucketQueue<uint32_t> pq(0);
+    return pq;
+}
+
+/*
+ * Arena indices are stored in 32 bits (queue entries, parent links) to
+ * keep every queued state at 4 bytes, and NO_NODE is reserved as "none".
+ * Reserve an arena slot and return its index, or throw once the arena
+ * holds NO_NODE states instead of letting indices wrap around.
+ */
+static const uint32_t NO_NODE = UINT32_MAX;
+
+template<class Arena>
+static uint32_t addSearchNode(Arena& arena) {
+    if(arena.size() >= NO_NODE) {
+        throw runtime_error("barrier search: more than 2^32 - 1 stored states");
+    }
+    return (uint32_t)arena.add();
+}
+
+// Syndrome H*x^T of a fixed-width state, from the columns of its set bits
+template<int W>
+static FixedState<W> syndromeOfFixed(const ParityCheckMatrix& H, const FixedState<W>& x) {
+    FixedState<W> syndrome{};
+    for(int c = 0; c < H.cols(); c++) {
+        if(!getBit(x.data(), c)) continue;
+        for(int r : H.col(c)) flipBit(syndrome.data(), r);
+    }
+    return syndrome;
+}
+
+/*
+ * Default hooks of a search goal (see barrierSearchFixed). Goals derive
+ * from this and override what they need.
+ */
+struct SearchGoal {
+    // Called once with the visited set before the search starts
+    template<class Visited>
+    void attach(const Visited&) {}
+
+    // Called with the peak level about to be expanded; true stops the search
+    bool stopAtLevel(int) const { return false; }
+
+    // May replace a new state by another of the same energy class (e.g. an
+    // orbit representative); true if x was changed
+    template<class State>
+    bool canonicalize(State&) const { return false; }
+
+    // States whose path peak would reach this value are never pushed
+    int peakCeiling() const { return INT_MAX; }
+};
+
+/*
+ * Search body shared by the barrier engines: a flood from the zero state
+ * in order of nondecreasing path peak. goal(x, energy, peak) is called
+ * once for every newly discovered state, with peak already minimal, and
+ * returning true stops the search, as does goal.stopAtLevel(peak) before
+ * a level is expanded. Neighbours with peak >= goal.peakCeiling() are
+ * dropped unvisited. Returns true if the goal stopped it, false once
+ * every reachable state below the ceiling has been expanded.
+ *
+ * Peak is the value type of the visited table and must hold every energy
+ * in [0, ℓ]; Visited is a PackedPeakTable or DensePeakArray
+ * (search_structures.hpp).
+ */
+template<int W, class Peak, class Visited, class Goal>
+static bool barrierSearchFixed(const ParityCheckMatrix& H, Visited& visited, Goal& goal) {
+    int n = H.cols();
+
+    // Flipping bit i flips exactly the checks in H.col(i), so each state
+    // carries its syndrome and a neighbour's energy costs O(column weight)
+    // instead of a full ℓ x n product.
+    //
+    // States live in this thread's arena and the queue only holds arena
+    // indices; the peak of an entry is the key of its bucket.
+    SlabArena<SearchNode<W>>& arena = threadSearchArena<W>();
+    MonotoneBucketQueue<uint32_t>& pq = threadSearchQueue();
+    arena.reset();
+    pq.clear();
+
+    // Start from the zero state, whose syndrome is all zeros
+    FixedState<W> zeroState{};
+    pq.push(0, (uint32_t)arena.add({zeroState, zeroState, 0}));
+    visited.insertOrImprove(zeroState.data(), 0);
+    goal.attach(visited);
+
+    // Dijkstra-like search in order of nondecreasing peak
+    while(!pq.empty()) {
+        int currPeak = pq.topKey();
+        if(goal.stopAtLevel(currPeak)) return true;
+        const SearchNode<W> curr = arena[pq.pop()];
+
+        // Explore neighbors by flipping each bit
+        for(int i = 0; i < n; i++){
+            int eNext = curr.energy + flipEnergyDelta(H.col(i), curr.syndrome.data());
+            int nextPeak = max(currPeak, eNext);
+            if(nextPeak >= goal.peakCeiling()) continue;
+
+            FixedState<W> nextState = curr.x;
+            flipBit(nextState.data(), i);  // flip bit i
+            bool moved = goal.canonicalize(nextState);
+
+            // Popped peaks never decrease, so the first time a state is
+            // reached its peak is already minimal: the goal can be
+            // checked on discovery and a visited state is never improved.
+            if(visited.insertOrImprove(nextState.data(), (Peak)nextPeak)) {
+                if(goal(nextState, eNext, nextPeak)) return true;
+                uint32_t index = addSearchNode(arena);
+                SearchNode<W>& next = arena[index];
+                next.x = nextState;
+                if(moved) {
+                    next.syndrome = syndromeOfFixed<W>(H, nextState);
+                } else {
+                    next.syndrome = curr.syndrome;
+                    for(int r : H.col(i)) flipBit(next.syndrome.data(), r);
+                }
+                next.energy = eNext;
+                pq.push(nextPeak, index);
+            }
+        }
+    }
+    return false;
+}
+
+static atomic<int> storageSetting{(int)VisitedStorage::Auto};
+static atomic<size_t> denseBudget{size_t(256) << 20};
+
+void setVisitedStorage(VisitedStorage storage) { storageSetting = (int)storage; }
+VisitedStorage visitedStorage() { return (VisitedStorage)storageSetting.load(); }
+
+void setDenseVisitedBudget(size_t bytes) { denseBudget = bytes; }
+size_t denseVisitedBudget() { return denseBudget; }
+
+// Whether the visited states of an n-bit search go to a Dense backend
+// (DensePeakArray or DenseVisitedBits) instead of a hash table
+template<class Dense>
+static bool useDenseVisited(int n) {
+    if(n > maxDenseVisitedBits()) return false;
+    switch(visitedStorage()) {
+        case VisitedStorage::Hash:  return false;
+        case VisitedStorage::Dense: return true;
+        default: return Dense::bytesFor(n) <= denseVisitedBudget();
+    }
+}
+
+// Call f(visited) with the visited backend selected for this code
+template<int W, class Peak, class F>
+static auto withVisitedStorage(const ParityCheckMatrix& H, F&& f) {
+    int n = H.cols();
+    if(useDenseVisited<DensePeakArray<Peak>>(n)) {
+        DensePeakArray<Peak> visited(n);
+        return f(visited);
+    }
+    PackedPeakTable<Peak, W> visited;
+    return f(visited);
+}
+
+// Run barrierSearchFixed with the visited backend selected for this code
+template<int W, class Peak, class Goal>
+static bool barrierSearchWithStorage(const ParityCheckMatrix& H, Goal& goal) {
+    return withVisitedStorage<W, Peak>(H, [&](auto& visited) {
+        return barrierSearchFixed<W, Peak>(H, visited, goal);
+    });
+}
+
+// One byte per visited peak unless energies can reach 255
+template<int W, class Goal>
+static bool runBarrierSearch(const ParityCheckMatrix& H, Goal& goal) {
+    if(H.rows() < 255) return barrierSearchWithStorage<W, uint8_t>(H, goal);
+    return barrierSearchWithStorage<W, uint16_t>(H, goal);
+}
+
+// Goal of the single-target search: stop at c_target, exploring only
+// paths that stay below ceiling (an upper bound the caller already has)
+template<int W>
+struct TargetGoal : SearchGoal {
+    FixedState<W> target{};
+    int barrier = -1;
+    int ceiling = INT_MAX;
+
+    int peakCeiling() const { return ceiling; }
+
+    bool operator()(const FixedState<W>& x, int, int peak) {
+        if(x != target) return false;
+        barrier = peak;
+        return true;
+    }
+};
+
+/*
+ * Width-specialized search. States and syndromes are FixedState<W>
+ * (std::array), so pushing a neighbour copies 2*W words and never touches
+ * the allocator; requires n <= 64*W and ℓ <= 64*W.
+ *
+ * With an upperBound U only states of energy < U are pushed; if c_target
+ * is not reached below U, U is returned.
+ */
+template<int W>
+int computeEnergyBarrierFixed(const ParityCheckMatrix& H, const vector<int>& c_target, int upperBound) {
     int n = (int)c_target.size();
+    if(n > 64 * W || H.rows() > 64 * W) {
+        throw invalid_argument("computeEnergyBarrierFixed: code does not fit the state width");
+    }
+    if(n != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierFixed: c_target length does not match H");
+    }
+    if(upperBound < 0) {
+        throw invalid_argument("computeEnergyBarrierFixed: upperBound is negative");
+    }
+
     // Check trivial case
     bool isAllZero = true;
     for(int bit : c_target) if(bit == 1) { isAllZero = false; break; }
@@ -51,79 +310,642 @@ int computeEnergyBarrier(const vector<vector<int>>& H, const vector<int>& c_targ
         return 0;
     }
 
-    // We'll represent states as bitstrings in an integer form if n <= ~32, 
-    // but let's do a vector<int> approach for clarity.
-    // The search space can be huge, so be mindful for large n.
+    TargetGoal<W> goal;
+    goal.ceiling = upperBound;
+    for(int c = 0; c < n; c++) {
+        if(c_target[c] & 1) flipBit(goal.target.data(), c);
+    }
+    if(!runBarrierSearch<W>(H, goal)) {
+        // Every path to c_target peaks at upperBound or above
+        if(upperBound != INT_MAX) return upperBound;
+
+        // If c_target is truly in the code, we should find it.
+        // If we get here, something is off or c_target isn't actually a codeword.
+        cerr << "ERROR: c_target not reachable. Is it a valid codeword?" << endl;
+        return -1;
+    }
+    return goal.barrier;
+}
+
+template int computeEnergyBarrierFixed<1>(const ParityCheckMatrix&, const vector<int>&, int);
+template int computeEnergyBarrierFixed<2>(const ParityCheckMatrix&, const vector<int>&, int);
+template int computeEnergyBarrierFixed<4>(const ParityCheckMatrix&, const vector<int>&, int);
+template int computeEnergyBarrierFixed<8>(const ParityCheckMatrix&, const vector<int>&, int);
+template int computeEnergyBarrierFixed<16>(const ParityCheckMatrix&, const vector<int>&, int);
+
+// Columns of a ParityCheckMatrix, as packedBarrierSearch reads them
+struct SparseColumnChecks {
+    const ParityCheckMatrix& H;
+
+    int cols() const { return H.cols(); }
+    int rows() const { return H.rows(); }
+
+    template<class F>
+    void forEachCheck(int bit, F f) const {
+        for(int r : H.col(bit)) f(r);
+    }
+};
+
+/*
+ * Codes wider than every FixedState instantiation: the same flood on
+ * run-time-width states (packed_search.hpp), with the state sized from n
+ * and the syndrome from ℓ separately.
+ */
+static int computeEnergyBarrierPacked(const ParityCheckMatrix& H, const vector<int>& c_target, int upperBound) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrier: c_target length does not match H");
+    }
+    if(upperBound < 0) {
+        throw invalid_argument("computeEnergyBarrier: upperBound is negative");
+    }
+    bool isAllZero = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(isAllZero) return 0;
+
+    int barrier = packedBarrierSearch(SparseColumnChecks{H}, packState(c_target), upperBound);
+    if(barrier >= 0) return barrier;
+    if(upperBound != INT_MAX) return upperBound;
+    cerr << "ERROR: c_target not reachable. Is it a valid codeword?" << endl;
+    return -1;
+}
+
+/*
+ * Runtime dispatcher: run the smallest width instantiation that holds both
+ * the n-bit states and the ℓ-bit syndromes, or the run-time-width flood
+ * when either exceeds maxFixedStateBits.
+ */
+int computeEnergyBarrier(const ParityCheckMatrix& H, const vector<int>& c_target, int upperBound) {
+    int bits = max((int)c_target.size(), H.rows());
+    if(bits > maxFixedStateBits) return computeEnergyBarrierPacked(H, c_target, upperBound);
+    return withStateWidth(bits, "computeEnergyBarrier", [&](auto w) {
+        return computeEnergyBarrierFixed<decltype(w)::value>(H, c_target, upperBound);
+    });
+}
+
+int computeEnergyBarrier(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    return computeEnergyBarrier(H, c_target, INT_MAX);
+}
 
-    // A structure to hold (peakSoFar, stateVector)
-    // We'll store the state as a string or vector<int>.
-    struct State {
-        int peak;
-        vector<int> x;
-        bool operator>(const State &other) const {
-            return peak > other.peak;
+int computeEnergyBarrier(const vector<vector<int>>& H, const vector<int>& c_target, int upperBound) {
+    return computeEnergyBarrier(ParityCheckMatrix(H), c_target, upperBound);
+}
+
+/*
+ * Goal of the profile search. Codewords have zero energy, so only states
+ * with energy 0 are looked up; each pending codeword receives the peak at
+ * which the flood first reaches it, and the search stops once none is left.
+ */
+template<int W>
+struct ProfileGoal : SearchGoal {
+    unordered_map<FixedState<W>, vector<int>, FixedStateHash<W>> pending;
+    vector<int>& barriers;
+
+    explicit ProfileGoal(vector<int>& out) : barriers(out) {}
+
+    bool operator()(const FixedState<W>& x, int energy, int peak) {
+        if(energy != 0) return false;
+        auto it = pending.find(x);
+        if(it == pending.end()) return false;
+        for(int idx : it->second) barriers[idx] = peak;
+        pending.erase(it);
+        return pending.empty();
+    }
+};
+
+template<int W>
+static vector<int> barrierProfileFixed(const ParityCheckMatrix& H, const vector<string>& codewords) {
+    vector<int> barriers(codewords.size(), -1);
+    ProfileGoal<W> goal(barriers);
+    for(size_t k = 0; k < codewords.size(); k++) {
+        FixedState<W> x{};
+        for(int c = 0; c < H.cols(); c++) {
+            if(codewords[k][c] == '1') flipBit(x.data(), c);
         }
-    };
-
-    // Priority queue (min-heap) based on 'peak'
-    priority_queue< State, vector<State>, greater<State> > pq;
-
-    // visited[state] will store the best known (lowest) max energy to reach 'state'.
-    // We'll store states in a std::unordered_map keyed by string representation for memory reasons.
-    // For bigger n, a more compact representation (bitset) might be needed.
-    unordered_map<string,int> visited;
-    
-    // Helper to convert a vector<int> to a string key
-    auto vecToString = [&](const vector<int>& v){
-        string s; s.reserve(n);
-        for(int b : v) s.push_back(b ? '1' : '0');
-        return s;
-    };
-
-    // Start from the zero state
-    vector<int> zeroState(n, 0);
-    int e0 = energyOfState(H, zeroState); // Typically 0 if zeroState is a codeword
-    State initState {e0, zeroState};
-    pq.push(initState);
-    visited[vecToString(zeroState)] = e0;
-
-    // BFS / Dijkstra-like search
-    while(!pq.empty()) {
-        State curr = pq.top();
-        pq.pop();
+        if(x == FixedState<W>{}) barriers[k] = 0;
+        else goal.pending[x].push_back((int)k);
+    }
+    if(goal.pending.empty()) return barriers;
+
+    if(!runBarrierSearch<W>(H, goal)) {
+        cerr << "ERROR: " << goal.pending.size()
+             << " codeword(s) not reachable. Are they valid codewords?" << endl;
+    }
+    return barriers;
+}
 
-        // If we've reached c_target, curr.peak is the minimal barrier
-        if(curr.x == c_target) {
-            return curr.peak;
+/*
+ * All barriers from one flood: the barrier to c is the peak at which the
+ * nondecreasing-peak search first reaches c, so a single search that runs
+ * until the last codeword is reached reports every one of them.
+ */
+vector<int> computeEnergyBarrierProfile(const ParityCheckMatrix& H, const vector<string>& codewords) {
+    for(const string& cw : codewords) {
+        if((int)cw.size() != H.cols()) {
+            throw invalid_argument("computeEnergyBarrierProfile: codeword length does not match H");
         }
+    }
+    return withStateWidth(max(H.cols(), H.rows()), "computeEnergyBarrierProfile", [&](auto w) {
+        return barrierProfileFixed<decltype(w)::value>(H, codewords);
+    });
+}
+
+vector<int> computeEnergyBarrierProfile(const vector<vector<int>>& H, const vector<string>& codewords) {
+    return computeEnergyBarrierProfile(ParityCheckMatrix(H), codewords);
+}
+
+// Goal of the code-level search: stop at the first nonzero codeword
+template<int W>
+struct CodewordGoal : SearchGoal {
+    FixedState<W> codeword{};
+    int barrier = -1;
+
+    bool operator()(const FixedState<W>& x, int energy, int peak) {
+        if(energy != 0) return false;
+        codeword = x;
+        barrier = peak;
+        return true;
+    }
+};
+
+template<int W>
+static int codeBarrierFixed(const ParityCheckMatrix& H, vector<int>& codeword) {
+    CodewordGoal<W> goal;
+    runBarrierSearch<W>(H, goal);
+    codeword.assign(H.cols(), 0);
+    for(int c = 0; c < H.cols(); c++) codeword[c] = getBit(goal.codeword.data(), c);
+    return goal.barrier;
+}
 
-        // If there's a better path to curr.x, skip
-        string currKey = vecToString(curr.x);
-        if(visited[currKey] < curr.peak) {
-            continue;
+/*
+ * Minimum barrier over the nonzero codewords from a single flood. The
+ * zero state is visited before the search starts, so the first discovered
+ * state with zero syndrome is a nonzero codeword, and the peak at which it
+ * is reached is the smallest barrier of any codeword.
+ */
+int computeCodeEnergyBarrier(const ParityCheckMatrix& H, vector<int>& codeword) {
+    codeword.clear();
+    // Full rank: the zero codeword is the only one
+    if(computeRankGF2(H) >= H.cols()) return -1;
+
+    return withStateWidth(max(H.cols(), H.rows()), "computeCodeEnergyBarrier", [&](auto w) {
+        return codeBarrierFixed<decltype(w)::value>(H, codeword);
+    });
+}
+
+int computeCodeEnergyBarrier(const ParityCheckMatrix& H) {
+    vector<int> codeword;
+    return computeCodeEnergyBarrier(H, codeword);
+}
+
+int computeCodeEnergyBarrier(const vector<vector<int>>& H, vector<int>& codeword) {
+    return computeCodeEnergyBarrier(ParityCheckMatrix(H), codeword);
+}
+
+int computeCodeEnergyBarrier(const vector<vector<int>>& H) {
+    return computeCodeEnergyBarrier(ParityCheckMatrix(H));
+}
+
+/*
+ * Goal of the bidirectional search. For a codeword c, x -> x ^ c maps the
+ * hypercube onto itself and preserves energy, so the frontier grown
+ * backward from c at any peak threshold is the mirror image of the
+ * forward one. A state y reached forward at peak p whose mirror y ^ c was
+ * reached forward at peak q closes a path 0 -> y -> c with peak
+ * max(p, q); the best such value is exact once the flood reaches it.
+ */
+template<int W, class Visited>
+struct MeetGoal : SearchGoal {
+    const Visited& visited;
+    FixedState<W> target;
+    int best = INT_MAX;
+
+    MeetGoal(const Visited& visited, const FixedState<W>& target) : visited(visited), target(target) {}
+
+    bool operator()(const FixedState<W>& x, int, int peak) {
+        FixedState<W> mirror;
+        for(int w = 0; w < W; w++) mirror[w] = x[w] ^ target[w];
+        int q = visited.find(mirror.data());
+        if(q >= 0) best = min(best, max(peak, q));
+        return false;
+    }
+
+    // Every later meeting has value >= the level being expanded
+    bool stopAtLevel(int level) const { return best <= level; }
+};
+
+// The goal looks peaks up in the flood's own visited set, so it is built
+// inside withVisitedStorage once the backend type is known
+template<int W, class Peak>
+static int meetSearch(const ParityCheckMatrix& H, const FixedState<W>& target) {
+    return withVisitedStorage<W, Peak>(H, [&](auto& visited) {
+        MeetGoal<W, decay_t<decltype(visited)>> goal(visited, target);
+        barrierSearchFixed<W, Peak>(H, visited, goal);
+        return goal.best;
+    });
+}
+
+template<int W>
+static int bidirectionalBarrierFixed(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    FixedState<W> target{};
+    for(int c = 0; c < H.cols(); c++) {
+        if(c_target[c] & 1) flipBit(target.data(), c);
+    }
+    int best = H.rows() < 255 ? meetSearch<W, uint8_t>(H, target) : meetSearch<W, uint16_t>(H, target);
+    return best == INT_MAX ? -1 : best;
+}
+
+/*
+ * Meet-in-the-middle barrier search from 0 and c_target. Both frontiers
+ * come out of one flood, so no state is evaluated twice; the search stops
+ * as soon as they meet at the current threshold, typically with about
+ * half the path length explored from each side.
+ */
+int computeEnergyBarrierBidirectional(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierBidirectional: c_target length does not match H");
+    }
+    // The mirror symmetry only holds for codewords
+    if(energyOfState(H, c_target) != 0) return computeEnergyBarrier(H, c_target);
+
+    bool isAllZero = true;
+    for(int bit : c_target) if(bit == 1) { isAllZero = false; break; }
+    if(isAllZero) return 0;
+
+    return withStateWidth(max(H.cols(), H.rows()), "computeEnergyBarrierBidirectional", [&](auto w) {
+        return bidirectionalBarrierFixed<decltype(w)::value>(H, c_target);
+    });
+}
+
+int computeEnergyBarrierBidirectional(const vector<vector<int>>& H, const vector<int>& c_target) {
+    return computeEnergyBarrierBidirectional(ParityCheckMatrix(H), c_target);
+}
+
+/*
+ * Goal of the symmetry-reduced search: TargetGoal plus canonicalization
+ * of every new state to the smallest image under a set of column
+ * automorphisms of H that fix c_target. Any automorphism preserves energy
+ * and fixes both 0 and c_target, so all states of an orbit have the same
+ * minimal peak and c_target's orbit is {c_target}. Mapping each state into
+ * its orbit therefore leaves the barrier unchanged, even when the element
+ * set is only part of the group.
+ */
+template<int W>
+struct SymmetricGoal : TargetGoal<W> {
+    int n = 0;
+    vector<int> perms;  // group elements back to back, n entries each
+    int count = 0;
+
+    bool canonicalize(FixedState<W>& x) const {
+        FixedState<W> best = x;
+        for(int g = 0; g < count; g++) {
+            const int* perm = &perms[(size_t)g * n];
+            FixedState<W> image{};
+            for(int w = 0; w < W; w++) {
+                for(uint64_t bits = x[w]; bits; bits &= bits - 1) {
+                    flipBit(image.data(), perm[64 * w + __builtin_ctzll(bits)]);
+                }
+            }
+            if(lexLess(image, best)) best = image;
         }
+        if(best == x) return false;
+        x = best;
+        return true;
+    }
 
-        // Explore neighbors by flipping each bit
-        for(int i = 0; i < n; i++){
-            vector<int> nextState = curr.x;
-            nextState[i] ^= 1;  // flip bit i
-            int eNext = energyOfState(H, nextState);
-            int nextPeak = max(curr.peak, eNext);
-
-            string nextKey = vecToString(nextState);
-            if(!visited.count(nextKey) || visited[nextKey] > nextPeak) {
-                visited[nextKey] = nextPeak;
-                pq.push({nextPeak, nextState});
+    // Order of states as n-bit integers
+    static bool lexLess(const FixedState<W>& a, const FixedState<W>& b) {
+        for(int w = W - 1; w >= 0; w--) {
+            if(a[w] != b[w]) return a[w] < b[w];
+        }
+        return false;
+    }
+};
+
+template<int W>
+static int symmetricBarrierFixed(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                 const vector<vector<int>>& elements) {
+    SymmetricGoal<W> goal;
+    for(int c = 0; c < H.cols(); c++) {
+        if(c_target[c] & 1) flipBit(goal.target.data(), c);
+    }
+    goal.n = H.cols();
+    for(const vector<int>& perm : elements) {
+        bool identity = true;
+        for(int c = 0; c < H.cols(); c++) if(perm[c] != c) { identity = false; break; }
+        if(identity) continue;
+        goal.perms.insert(goal.perms.end(), perm.begin(), perm.end());
+        goal.count++;
+    }
+    if(!runBarrierSearch<W>(H, goal)) {
+        cerr << "ERROR: c_target not reachable. Is it a valid codeword?" << endl;
+        return -1;
+    }
+    return goal.barrier;
+}
+
+/*
+ * Barrier search on orbit representatives under caller-supplied column
+ * automorphisms of H that fix c_target; see SymmetricGoal.
+ */
+int computeEnergyBarrierWithSymmetry(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                     const vector<vector<int>>& groupElements) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierWithSymmetry: c_target length does not match H");
+    }
+    for(const vector<int>& perm : groupElements) {
+        if(!isColumnAutomorphism(H, perm)) {
+            throw invalid_argument("computeEnergyBarrierWithSymmetry: element is not an automorphism of H");
+        }
+        for(int c = 0; c < H.cols(); c++) {
+            if((c_target[c] & 1) != (c_target[perm[c]] & 1)) {
+                throw invalid_argument("computeEnergyBarrierWithSymmetry: element does not fix c_target");
             }
         }
     }
+    bool isAllZero = true;
+    for(int bit : c_target) if(bit == 1) { isAllZero = false; break; }
+    if(isAllZero) return 0;
 
-    // If c_target is truly in the code, we should find it.
-    // If we get here, something is off or c_target isn't actually a codeword.
-    cerr << "ERROR: c_target not reachable. Is it a valid codeword?" << endl;
-    return -1;
+    return withStateWidth(max(H.cols(), H.rows()), "computeEnergyBarrierWithSymmetry", [&](auto w) {
+        return symmetricBarrierFixed<decltype(w)::value>(H, c_target, groupElements);
+    });
+}
+
+int computeEnergyBarrierSymmetric(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                  size_t maxGroupElements) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierSymmetric: c_target length does not match H");
+    }
+    vector<vector<int>> elements =
+        permutationGroupElements(findColumnAutomorphisms(H, c_target), H.cols(), maxGroupElements);
+    return computeEnergyBarrierWithSymmetry(H, c_target, elements);
+}
+
+int computeEnergyBarrierSymmetric(const vector<vector<int>>& H, const vector<int>& c_target,
+                                  size_t maxGroupElements) {
+    return computeEnergyBarrierSymmetric(ParityCheckMatrix(H), c_target, maxGroupElements);
+}
+
+// A threshold-search state; parent/bit link it to its predecessor
+template<int W>
+struct ThresholdNode {
+    FixedState<W> x;
+    FixedState<W> syndrome;
+    int energy;
+    uint32_t parent;
+    int bit;
+};
+
+template<int W>
+static SlabArena<ThresholdNode<W>>& threadThresholdArena() {
+    thread_local SlabArena<ThresholdNode<W>> arena;
+    return arena;
+}
+
+/*
+ * Breadth-first search over the states with energy < T. The arena doubles
+ * as the FIFO queue: nodes are appended in BFS order and expanded by
+ * index. On success flipPath receives the bits flipped along the (fewest
+ * flips) path found.
+ */
+template<int W, class Visited>
+static bool thresholdSearchFixed(const ParityCheckMatrix& H, const FixedState<W>& target,
+                                 int T, Visited& visited, vector<int>& flipPath,
+                                 LimitTracker* tracker) {
+    int n = H.cols();
+    SlabArena<ThresholdNode<W>>& arena = threadThresholdArena<W>();
+    arena.reset();
+
+    FixedState<W> zeroState{};
+    arena.add({zeroState, zeroState, 0, NO_NODE, -1});
+    visited.insertOrImprove(zeroState.data(), 0);
+
+    for(size_t head = 0; head < arena.size(); head++) {
+        if(tracker && tracker->expired()) return false;
+
+        // Slabs never move, so the reference survives later add() calls
+        const ThresholdNode<W>& curr = arena[head];
+        for(int i = 0; i < n; i++) {
+            int eNext = curr.energy + flipEnergyDelta(H.col(i), curr.syndrome.data());
+            if(eNext >= T) continue;
+
+            FixedState<W> nextState = curr.x;
+            flipBit(nextState.data(), i);
+            if(!visited.insertOrImprove(nextState.data(), 0)) continue;
+
+            uint32_t index = addSearchNode(arena);
+            ThresholdNode<W>& next = arena[index];
+            next.x = nextState;
+            next.syndrome = curr.syndrome;
+            for(int r : H.col(i)) flipBit(next.syndrome.data(), r);
+            next.energy = eNext;
+            next.parent = (uint32_t)head;
+            next.bit = i;
+
+            if(nextState == target) {
+                flipPath.clear();
+                for(uint32_t k = index; arena[k].parent != NO_NODE; k = arena[k].parent) {
+                    flipPath.push_back(arena[k].bit);
+                }
+                reverse(flipPath.begin(), flipPath.end());
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
+template<int W>
+static bool barrierBelowFixed(const ParityCheckMatrix& H, const vector<int>& c_target,
+                              int T, vector<int>& flipPath, LimitTracker* tracker = nullptr) {
+    FixedState<W> target{};
+    for(int c = 0; c < H.cols(); c++) {
+        if(c_target[c] & 1) flipBit(target.data(), c);
+    }
+    if(useDenseVisited<DenseVisitedBits>(H.cols())) {
+        DenseVisitedBits visited(H.cols());
+        return thresholdSearchFixed<W>(H, target, T, visited, flipPath, tracker);
+    }
+    PackedPeakTable<uint8_t, W> visited;
+    return thresholdSearchFixed<W>(H, target, T, visited, flipPath, tracker);
+}
+
+/*
+ * Decision query: is there a flip path from 0 to c_target whose states all
+ * have energy < T? Only that sublevel set is explored, so a "no" costs far
+ * less than computing the barrier when T is below it.
+ */
+bool energyBarrierBelow(const ParityCheckMatrix& H, const vector<int>& c_target, int T,
+                        vector<int>& flipPath) {
+    flipPath.clear();
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("energyBarrierBelow: c_target length does not match H");
+    }
+    if(T <= 0) return false;
+
+    bool isAllZero = true;
+    for(int bit : c_target) if(bit == 1) { isAllZero = false; break; }
+    if(isAllZero) return true;
+
+    return withStateWidth(max(H.cols(), H.rows()), "energyBarrierBelow", [&](auto w) {
+        return barrierBelowFixed<decltype(w)::value>(H, c_target, T, flipPath);
+    });
+}
+
+bool energyBarrierBelow(const ParityCheckMatrix& H, const vector<int>& c_target, int T) {
+    vector<int> flipPath;
+    return energyBarrierBelow(H, c_target, T, flipPath);
+}
+
+bool energyBarrierBelow(const vector<vector<int>>& H, const vector<int>& c_target, int T,
+                        vector<int>& flipPath) {
+    return energyBarrierBelow(ParityCheckMatrix(H), c_target, T, flipPath);
+}
+
+bool energyBarrierBelow(const vector<vector<int>>& H, const vector<int>& c_target, int T) {
+    return energyBarrierBelow(ParityCheckMatrix(H), c_target, T);
+}
+
+/*
+ * TargetGoal that charges every expanded state to a LimitTracker and
+ * remembers the peak level being expanded when it stopped.
+ */
+template<int W>
+struct LimitedTargetGoal : TargetGoal<W> {
+    LimitTracker tracker;
+    int level = 0;
+
+    explicit LimitedTargetGoal(const SearchLimits& limits) : tracker(limits) {}
+
+    bool stopAtLevel(int peak) {
+        level = peak;
+        return tracker.expired();
+    }
+};
+
+/*
+ * Peak of a greedy path from 0 to c_target that flips the bits of its
+ * support one at a time, each time the one leading to the lowest energy.
+ * Like every path it bounds the barrier from above.
+ */
+static int greedyPathPeak(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    vector<int> remaining;
+    for(int c = 0; c < H.cols(); c++) {
+        if(c_target[c] & 1) remaining.push_back(c);
+    }
+    vector<char> syndrome(H.rows(), 0);
+    int energy = 0, peak = 0;
+    while(!remaining.empty()) {
+        size_t best = 0;
+        int bestDelta = INT_MAX;
+        for(size_t k = 0; k < remaining.size(); k++) {
+            int delta = 0;
+            for(int r : H.col(remaining[k])) delta += syndrome[r] ? -1 : 1;
+            if(delta < bestDelta) {
+                bestDelta = delta;
+                best = k;
+            }
+        }
+        for(int r : H.col(remaining[best])) syndrome[r] ^= 1;
+        energy += bestDelta;
+        peak = max(peak, energy);
+        remaining.erase(remaining.begin() + best);
+    }
+    return peak;
+}
+
+template<int W>
+static BarrierResult barrierLimitedFixed(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                         const SearchLimits& limits, int upperBound) {
+    LimitedTargetGoal<W> goal(limits);
+    goal.ceiling = upperBound;
+    for(int c = 0; c < H.cols(); c++) {
+        if(c_target[c] & 1) flipBit(goal.target.data(), c);
+    }
+    runBarrierSearch<W>(H, goal);
+
+    BarrierResult result;
+    result.statesExplored = goal.tracker.expansions();
+    if(goal.barrier >= 0) {
+        result.barrier = result.lowerBound = result.upperBound = goal.barrier;
+    } else if(goal.tracker.status() != SearchStatus::Complete) {
+        // Every state of peak below the current level has been expanded
+        result.status = goal.tracker.status();
+        result.lowerBound = max(goal.level, energyOfState(H, c_target));
+        result.upperBound = min(greedyPathPeak(H, c_target), upperBound);
+    } else if(upperBound != INT_MAX) {
+        // No path stays below the bound the caller supplied
+        result.barrier = result.lowerBound = result.upperBound = upperBound;
+    }
+    return result;
+}
+
+/*
+ * computeEnergyBarrier under SearchLimits: the same flood, which checks
+ * the limits before each expansion and on expiry reports the level it
+ * had reached as a lower bound and a greedy path as an upper bound.
+ */
+BarrierResult computeEnergyBarrierLimited(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                          const SearchLimits& limits, int upperBound) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierLimited: c_target length does not match H");
+    }
+    if(upperBound < 0) {
+        throw invalid_argument("computeEnergyBarrierLimited: upperBound is negative");
+    }
+    BarrierResult result;
+    bool isAllZero = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(isAllZero) {
+        result.barrier = result.upperBound = 0;
+        return result;
+    }
+    return withStateWidth(max(H.cols(), H.rows()), "computeEnergyBarrierLimited", [&](auto w) {
+        return barrierLimitedFixed<decltype(w)::value>(H, c_target, limits, upperBound);
+    });
+}
+
+BarrierResult computeEnergyBarrierLimited(const vector<vector<int>>& H, const vector<int>& c_target,
+                                          const SearchLimits& limits, int upperBound) {
+    return computeEnergyBarrierLimited(ParityCheckMatrix(H), c_target, limits, upperBound);
+}
+
+/*
+ * energyBarrierBelow under SearchLimits. A decided query is reported as a
+ * bound: upperBound = T - 1 if the barrier is below T, lowerBound = T if
+ * it is not.
+ */
+BarrierResult energyBarrierBelowLimited(const ParityCheckMatrix& H, const vector<int>& c_target, int T,
+                                        const SearchLimits& limits) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("energyBarrierBelowLimited: c_target length does not match H");
+    }
+    BarrierResult result;
+    result.lowerBound = energyOfState(H, c_target);
+    bool isAllZero = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(isAllZero) {
+        result.barrier = result.upperBound = 0;
+        return result;
+    }
+    if(T <= 0) {
+        result.lowerBound = max(result.lowerBound, T);
+        return result;
+    }
+
+    LimitTracker tracker(limits);
+    vector<int> flipPath;
+    bool below = withStateWidth(max(H.cols(), H.rows()), "energyBarrierBelowLimited", [&](auto w) {
+        return barrierBelowFixed<decltype(w)::value>(H, c_target, T, flipPath, &tracker);
+    });
+    result.statesExplored = tracker.expansions();
+    result.status = tracker.status();
+    if(below) result.upperBound = T - 1;
+    else if(result.complete()) result.lowerBound = max(result.lowerBound, T);
+    return result;
+}
+
+BarrierResult energyBarrierBelowLimited(const vector<vector<int>>& H, const vector<int>& c_target, int T,
+                                        const SearchLimits& limits) {
+    return energyBarrierBelowLimited(ParityCheckMatrix(H), c_target, T, limits);
+}
 
 
 // ------------------- Example usage -------------------
@@ -163,5 +985,3 @@ int computeEnergyBarrier(const vector<vector<int>>& H, const vector<int>& c_targ
 
 //     return 0;
 // }
-
-
@@ -0,0 +1,227 @@
+#include "../include/energy_barrier_bounds.hpp"
+#include "../include/energy_barrier.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/search_structures.hpp"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+using namespace std;
+
+vector<int> supportNeighbourhoodBits(const ParityCheckMatrix& H, const vector<int>& c_target, int slackBits) {
+    int n = H.cols();
+    if((int)c_target.size() != n) {
+        throw invalid_argument("supportNeighbourhoodBits: c_target length does not match H");
+    }
+
+    vector<char> chosen(n, 0);
+    vector<int> ring;
+    for(int c = 0; c < n; c++) {
+        if(c_target[c] & 1) {
+            chosen[c] = 1;
+            ring.push_back(c);
+        }
+    }
+
+    // Grow outward one ring of the Tanner graph at a time
+    vector<int> shared(n, 0);
+    int remaining = max(slackBits, 0);
+    while(remaining > 0 && !ring.empty()) {
+        vector<int> candidates;
+        for(int b : ring) {
+            for(int r : H.col(b)) {
+                for(int c : H.row(r)) {
+                    if(chosen[c]) continue;
+                    if(shared[c]++ == 0) candidates.push_back(c);
+                }
+            }
+        }
+        stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+            return shared[a] != shared[b] ? shared[a] > shared[b] : a < b;
+        });
+        if((int)candidates.size() > remaining) candidates.resize(remaining);
+        for(int c : candidates) chosen[c] = 1;
+        remaining -= (int)candidates.size();
+        for(int c = 0; c < n; c++) shared[c] = 0;
+        ring.swap(candidates);
+    }
+
+    vector<int> bits;
+    for(int c = 0; c < n; c++) if(chosen[c]) bits.push_back(c);
+    return bits;
+}
+
+int computeEnergyBarrierRestricted(const ParityCheckMatrix& H, const vector<int>& c_target, int slackBits) {
+    vector<int> bits = supportNeighbourhoodBits(H, c_target, slackBits);
+
+    // Columns of the allowed bits; checks none of them touch can never
+    // be violated and are dropped, which keeps the state width small.
+    vector<int> rowIndex(H.rows(), -1);
+    int rows = 0;
+    vector<pair<int,int>> entries;
+    for(int j = 0; j < (int)bits.size(); j++) {
+        for(int r : H.col(bits[j])) {
+            if(rowIndex[r] < 0) rowIndex[r] = rows++;
+            entries.push_back({rowIndex[r], j});
+        }
+    }
+    ParityCheckMatrix restricted(rows, (int)bits.size(), entries);
+
+    vector<int> target(bits.size());
+    for(size_t j = 0; j < bits.size(); j++) target[j] = c_target[bits[j]] & 1;
+    return computeEnergyBarrier(restricted, target);
+}
+
+int computeEnergyBarrierRestricted(const vector<vector<int>>& H, const vector<int>& c_target, int slackBits) {
+    return computeEnergyBarrierRestricted(ParityCheckMatrix(H), c_target, slackBits);
+}
+
+/*
+ * Extension of a beam state by one flip, ranked by (peak, energy,
+ * distance); parent and bit identify it until it is materialized.
+ */
+struct BeamCandidate {
+    int peak;
+    int energy;
+    int distance;
+    int parent;
+    int bit;
+};
+
+/*
+ * Beam search body. Only paths with peak below incumbent are kept;
+ * returns the best peak found (incumbent if none beats it) and its flips.
+ */
+static int beamSearch(const ParityCheckMatrix& H, const vector<int>& c_target, int beamWidth,
+                      int detourFlips, int incumbent, vector<int>& flipPath) {
+    int n = H.cols();
+    int sw = wordsForBits(n), rw = wordsForBits(H.rows());
+    PackedState target = packState(c_target);
+    int weight = 0;
+    for(uint64_t w : target) weight += __builtin_popcountll(w);
+    int maxDepth = weight + 2 * detourFlips;
+
+    // The beam: states and syndromes back to back, sw and rw words each
+    vector<uint64_t> states(sw, 0), syndromes(rw, 0);
+    vector<int> energy{0}, peak{0}, distance{weight}, lastFlip{-1};
+
+    // links[d][k]: (beam index at depth d, bit flipped) of beam state k at depth d + 1
+    vector<vector<pair<int,int>>> links;
+    int best = incumbent;
+    vector<BeamCandidate> candidates;
+
+    for(int depth = 0; depth < maxDepth && !energy.empty(); depth++) {
+        int budget = maxDepth - depth - 1;
+        candidates.clear();
+        for(int k = 0; k < (int)energy.size(); k++) {
+            const uint64_t* x = &states[(size_t)k * sw];
+            const uint64_t* syndrome = &syndromes[(size_t)k * rw];
+            for(int i = 0; i < n; i++) {
+                // Undoing the last flip only leads back to the parent
+                if(i == lastFlip[k]) continue;
+                int d = distance[k] + (getBit(x, i) == getBit(target.data(), i) ? 1 : -1);
+                if(d > budget) continue;
+                int e = energy[k] + flipEnergyDelta(H.col(i), syndrome);
+                int p = max(peak[k], e);
+                if(p < best) candidates.push_back({p, e, d, k, i});
+            }
+        }
+        sort(candidates.begin(), candidates.end(), [](const BeamCandidate& a, const BeamCandidate& b) {
+            if(a.peak != b.peak) return a.peak < b.peak;
+            if(a.energy != b.energy) return a.energy < b.energy;
+            if(a.distance != b.distance) return a.distance < b.distance;
+            return a.parent != b.parent ? a.parent < b.parent : a.bit < b.bit;
+        });
+
+        // Keep the best beamWidth distinct states. Reaching c_target ends
+        // a path; candidates are sorted by peak, so the first such path is
+        // the best one of this depth.
+        vector<uint64_t> nextStates, nextSyndromes;
+        vector<int> nextEnergy, nextPeak, nextDistance, nextLastFlip;
+        vector<pair<int,int>> nextLinks;
+        PackedPeakTable<uint8_t> seen(sw, beamWidth);
+        PackedState x(sw);
+        for(const BeamCandidate& cand : candidates) {
+            if((int)nextEnergy.size() == beamWidth || cand.peak >= best) break;
+            if(cand.distance == 0) {
+                best = cand.peak;
+                flipPath.assign(1, cand.bit);
+                for(int d = depth - 1, k = cand.parent; d >= 0; d--) {
+                    flipPath.push_back(links[d][k].second);
+                    k = links[d][k].first;
+                }
+                reverse(flipPath.begin(), flipPath.end());
+                continue;
+            }
+            copy(&states[(size_t)cand.parent * sw], &states[(size_t)(cand.parent + 1) * sw], x.begin());
+            flipBit(x.data(), cand.bit);
+            if(!seen.insertOrImprove(x.data(), 0)) continue;
+
+            nextStates.insert(nextStates.end(), x.begin(), x.end());
+            size_t offset = nextSyndromes.size();
+            nextSyndromes.insert(nextSyndromes.end(), &syndromes[(size_t)cand.parent * rw],
+                                 &syndromes[(size_t)(cand.parent + 1) * rw]);
+            for(int r : H.col(cand.bit)) flipBit(&nextSyndromes[offset], r);
+            nextEnergy.push_back(cand.energy);
+            nextPeak.push_back(cand.peak);
+            nextDistance.push_back(cand.distance);
+            nextLastFlip.push_back(cand.bit);
+            nextLinks.push_back({cand.parent, cand.bit});
+        }
+        states.swap(nextStates);
+        syndromes.swap(nextSyndromes);
+        energy.swap(nextEnergy);
+        peak.swap(nextPeak);
+        distance.swap(nextDistance);
+        lastFlip.swap(nextLastFlip);
+        links.push_back(move(nextLinks));
+    }
+    return best;
+}
+
+int computeEnergyBarrierBeam(const ParityCheckMatrix& H, const vector<int>& c_target,
+                             int beamWidth, int detourFlips, vector<int>& flipPath) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierBeam: c_target length does not match H");
+    }
+    if(beamWidth < 1) throw invalid_argument("computeEnergyBarrierBeam: beamWidth must be at least 1");
+    if(detourFlips < 0) throw invalid_argument("computeEnergyBarrierBeam: detourFlips is negative");
+
+    // Flipping supp(c_target) in any order is a path, so the search always
+    // finds one: the flips toward c_target never leave the detour budget.
+    flipPath.clear();
+    bool isAllZero = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(isAllZero) return 0;
+    return beamSearch(H, c_target, beamWidth, detourFlips, INT_MAX, flipPath);
+}
+
+int computeEnergyBarrierBeam(const ParityCheckMatrix& H, const vector<int>& c_target,
+                             int beamWidth, int detourFlips) {
+    vector<int> flipPath;
+    return computeEnergyBarrierBeam(H, c_target, beamWidth, detourFlips, flipPath);
+}
+
+int computeEnergyBarrierBeam(const vector<vector<int>>& H, const vector<int>& c_target,
+                             int beamWidth, int detourFlips, vector<int>& flipPath) {
+    return computeEnergyBarrierBeam(ParityCheckMatrix(H), c_target, beamWidth, detourFlips, flipPath);
+}
+
+int computeEnergyBarrierBeam(const vector<vector<int>>& H, const vector<int>& c_target,
+                             int beamWidth, int detourFlips) {
+    return computeEnergyBarrierBeam(ParityCheckMatrix(H), c_target, beamWidth, detourFlips);
+}
+
+vector<pair<int,int>> computeEnergyBarrierBeamSweep(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                                    int maxBeamWidth, int detourFlips) {
+    if(maxBeamWidth < 1) throw invalid_argument("computeEnergyBarrierBeamSweep: maxBeamWidth must be at least 1");
+    vector<int> flipPath;
+    int bound = computeEnergyBarrierBeam(H, c_target, 1, detourFlips, flipPath);
+    vector<pair<int,int>> sweep{{1, bound}};
+    for(int width = 2; width / 2 < maxBeamWidth; width *= 2) {
+        int w = min(width, maxBeamWidth);
+        bound = beamSearch(H, c_target, w, detourFlips, bound, flipPath);
+        sweep.push_back({w, bound});
+        if(w == maxBeamWidth) break;
+    }
+    return sweep;
+}
@@ -1,11 +1,15 @@
 #include <iostream>
 #include <vector>
 #include <queue>
-#include <unordered_map>
 #include <string>
 #include <algorithm>
 #include <functional>
 #include <climits>
+#include <stdexcept>
+#include "../include/gf2_packed.hpp"
+#include "../include/search_structures.hpp"
+#include "../include/search_limits.hpp"
+#include "../include/energy_barrier_exhaust.hpp"
 using namespace std;
 
 /*
@@ -28,49 +32,34 @@ int energyOfStateex(const vector<vector<int>>& H, const vector<int>& x) {
 }
 
 /*
- * Exhaustively try ALL single-bit-flip paths from 0^n to c_target.
- * Track the minimal possible peak energy (barrier).
- *
- * This is exponential in the worst case (potentially exploring 
- * many paths if we allow revisits). We prune whenever we revisit 
- * a state with a worse or equal barrier than already found.
+ * DFS body of computeEnergyBarrierExhaustive over packed states. Peak is
+ * the value type of the visited table and must hold every energy in [0, ℓ].
+ * Every DFS call is charged to tracker; once it expires the recursion
+ * unwinds and the best barrier found so far is returned. The search starts
+ * from the incumbent barrier (INT_MAX if none) and returns it unchanged if
+ * no path beats it.
  */
-int computeEnergyBarrierExhaustive(
-    const vector<vector<int>>& H,       // Parity-check matrix (ℓ x n)
-    const vector<int>& c_target        // target codeword in {0,1}^n
-){
-    int n = (int)c_target.size();
-    
-    // Quick check if c_target is the all-zero codeword
-    bool allZero = true;
-    for(int b : c_target) {
-        if(b == 1){ allZero = false; break; }
-    }
-    if(allZero) {
-        return 0; // trivial barrier
-    }
+template<class Peak>
+static int exhaustiveSearch(const PackedMatrix& PH, const PackedState& target, int n,
+                            LimitTracker& tracker, int incumbent) {
+    const int W = (int)target.size();
 
     // We'll store the minimum barrier found for each visited state to prune paths
-    // key: string representation of the n-bit state, value: best (lowest) barrier so far
-    unordered_map<string,int> bestBarrierForState;
-
-    // Convert a state vector<int> to a string "0101..."
-    auto vecToString = [&](const vector<int>& v){
-        string s; s.reserve(v.size());
-        for(int bit : v) s.push_back(bit ? '1':'0');
-        return s;
-    };
+    // key: packed n-bit state, value: best (lowest) barrier so far
+    PackedPeakTable<Peak> bestBarrierForState(W);
 
     // A global variable (or captured reference) to store the best barrier found
     // for a path that reaches c_target.
-    int globalMinBarrier = INT_MAX;
+    int globalMinBarrier = incumbent;
 
     // Depth-first search (DFS) recursion
     // currentState: current bit configuration
     // currentBarrier: the highest energy encountered so far along the path
-    function<void(vector<int>,int)> dfs = [&](vector<int> state, int currentBarrier){
+    function<void(const PackedState&,int)> dfs = [&](const PackedState& state, int currentBarrier){
+        if(tracker.expired()) return;
+
         // If we've reached c_target, update globalMinBarrier
-        if(state == c_target) {
+        if(state == target) {
             globalMinBarrier = min(globalMinBarrier, currentBarrier);
             return;
         }
@@ -81,28 +70,69 @@ int computeEnergyBarrierExhaustive(
         }
 
         // Explore single-bit flips from 'state'
+        PackedState nextState = state;
         for(int i = 0; i < n; i++){
-            vector<int> nextState = state;
-            nextState[i] ^= 1; // flip bit i
-            int eNext = energyOfStateex(H, nextState);
+            flipBit(nextState.data(), i); // flip bit i
+            int eNext = energyOfStatePacked(PH, nextState);
             int nextBarrier = max(currentBarrier, eNext);
 
-            // If we haven't visited nextState or found a better barrier now:
-            string key = vecToString(nextState);
-            if(!bestBarrierForState.count(key) || bestBarrierForState[key] > nextBarrier){
-                bestBarrierForState[key] = nextBarrier;
+            // If nextState can still beat the best path and we haven't
+            // visited it or found a better barrier now:
+            if(nextBarrier < globalMinBarrier &&
+               bestBarrierForState.insertOrImprove(nextState.data(), (Peak)nextBarrier)){
                 dfs(nextState, nextBarrier);
             }
+            flipBit(nextState.data(), i); // restore bit i
         }
     };
 
     // Start from zero state
-    vector<int> zeroState(n, 0);
-    int e0 = energyOfStateex(H, zeroState); // usually 0 if zeroState is a valid codeword
-    bestBarrierForState[vecToString(zeroState)] = e0;
+    PackedState zeroState(W, 0);
+    int e0 = energyOfStatePacked(PH, zeroState); // usually 0 if zeroState is a valid codeword
+    bestBarrierForState.insertOrImprove(zeroState.data(), (Peak)e0);
 
     // Launch DFS
     dfs(zeroState, e0);
+    return globalMinBarrier;
+}
+
+// Run exhaustiveSearch with the peak width H needs
+static int exhaustiveBarrier(const vector<vector<int>>& H, const vector<int>& c_target,
+                             LimitTracker& tracker, int incumbent = INT_MAX) {
+    // States and H are bit-packed (see gf2_packed.hpp) so every energy
+    // evaluation is one popcount per row instead of n int operations.
+    PackedMatrix PH = packMatrix(H);
+    PackedState target = packState(c_target);
+    int n = (int)c_target.size();
+
+    // One byte per visited peak unless energies can reach 255
+    if(PH.rows < 255) return exhaustiveSearch<uint8_t>(PH, target, n, tracker, incumbent);
+    return exhaustiveSearch<uint16_t>(PH, target, n, tracker, incumbent);
+}
+
+/*
+ * Exhaustively try ALL single-bit-flip paths from 0^n to c_target.
+ * Track the minimal possible peak energy (barrier).
+ *
+ * This is exponential in the worst case (potentially exploring 
+ * many paths if we allow revisits). We prune whenever we revisit 
+ * a state with a worse or equal barrier than already found.
+ */
+int computeEnergyBarrierExhaustive(
+    const vector<vector<int>>& H,       // Parity-check matrix (ℓ x n)
+    const vector<int>& c_target        // target codeword in {0,1}^n
+){
+    // Quick check if c_target is the all-zero codeword
+    bool allZero = true;
+    for(int b : c_target) {
+        if(b == 1){ allZero = false; break; }
+    }
+    if(allZero) {
+        return 0; // trivial barrier
+    }
+
+    LimitTracker unlimited{SearchLimits()};
+    int globalMinBarrier = exhaustiveBarrier(H, c_target, unlimited);
 
     // If globalMinBarrier is still INT_MAX, it means c_target wasn't reached
     if(globalMinBarrier == INT_MAX) {
@@ -110,10 +140,51 @@ int computeEnergyBarrierExhaustive(
         cerr << "Exhaustive search: c_target not reached. Possibly invalid codeword." << endl;
         return -1;
     }
-
     return globalMinBarrier;
 }
 
+/*
+ * computeEnergyBarrierExhaustive seeded with a known achievable barrier.
+ */
+int computeEnergyBarrierExhaustive(const vector<vector<int>>& H, const vector<int>& c_target,
+                                   int upperBound) {
+    if(upperBound < 0) {
+        throw invalid_argument("computeEnergyBarrierExhaustive: upperBound is negative");
+    }
+    bool allZero = none_of(c_target.begin(), c_target.end(), [](int b) { return b == 1; });
+    if(allZero) return 0;
+
+    LimitTracker unlimited{SearchLimits()};
+    return exhaustiveBarrier(H, c_target, unlimited, upperBound);
+}
+
+/*
+ * computeEnergyBarrierExhaustive under SearchLimits. A stopped DFS has no
+ * level structure, so its lower bound is E(c_target); the best path it
+ * completed, if any, is the upper bound.
+ */
+BarrierResult computeEnergyBarrierExhaustive(const vector<vector<int>>& H, const vector<int>& c_target,
+                                             const SearchLimits& limits) {
+    BarrierResult result;
+    bool allZero = none_of(c_target.begin(), c_target.end(), [](int b) { return b == 1; });
+    if(allZero) {
+        result.barrier = result.upperBound = 0;
+        return result;
+    }
+
+    LimitTracker tracker(limits);
+    int best = exhaustiveBarrier(H, c_target, tracker);
+    result.statesExplored = tracker.expansions();
+    result.status = tracker.status();
+    if(result.complete()) {
+        if(best != INT_MAX) result.barrier = result.lowerBound = result.upperBound = best;
+    } else {
+        result.lowerBound = energyOfStateex(H, c_target);
+        if(best != INT_MAX) result.upperBound = best;
+    }
+    return result;
+}
+
 /*
  * Helper function for recursive path exploration
  */
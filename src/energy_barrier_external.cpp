@@ -0,0 +1,717 @@
+#include "../include/energy_barrier_external.hpp"
+#include "../include/energy_barrier.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/gf2_batch.hpp"
+#include <vector>
+#include <string>
+#include <queue>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+using namespace std;
+
+// Bytes of stdio buffer per open run file
+static const size_t runBufferBytes = size_t(1) << 18;
+
+// New states are scored in blocks of this many with energyOfStatesBatch;
+// a final block smaller than minEnergyBatch is scored state by state
+static const size_t energyBatchStates = 4096;
+static const size_t minEnergyBatch = 256;
+
+// States compare as 64W-bit integers with word W-1 most significant
+template<int W>
+static bool stateLess(const FixedState<W>& a, const FixedState<W>& b) {
+    for(int w = W - 1; w >= 0; w--) {
+        if(a[w] != b[w]) return a[w] < b[w];
+    }
+    return false;
+}
+
+/*
+ * Whether 'name' is a file the search writes: run<digits>, checkpoint or
+ * checkpoint.tmp. Nothing else in a checkpoint directory is ever deleted.
+ */
+static bool isSearchFileName(const string& name) {
+    if(name == "checkpoint" || name == "checkpoint.tmp") return true;
+    if(name.size() <= 3 || name.compare(0, 3, "run") != 0) return false;
+    return all_of(name.begin() + 3, name.end(), [](char ch) { return ch >= '0' && ch <= '9'; });
+}
+
+// fsync a file or directory by name; false on failure
+static bool syncPath(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    ok &= close(fd) == 0;
+    return ok;
+}
+
+/*
+ * Directory holding the run files of one search. Files are handed out by
+ * newFile() and deleted by removeFile().
+ *
+ * Without checkpointing the directory is private (mkdtemp) and removed
+ * with everything in it by the destructor. A checkpoint directory
+ * outlives the search: a file the last checkpoint refers to is only
+ * deleted once the next checkpoint no longer needs it (protect()), and
+ * discard() deletes the search's files after the search has finished;
+ * other files in the directory are left alone.
+ */
+class ScratchDirectory {
+public:
+    ScratchDirectory(const string& parent, const string& checkpointDir) {
+        if(!checkpointDir.empty()) {
+            path = checkpointDir;
+            persistent = true;
+            if(mkdir(path.c_str(), 0777) != 0 && errno != EEXIST) {
+                throw runtime_error("computeEnergyBarrierExternal: cannot create " + path);
+            }
+            return;
+        }
+        string base = parent;
+        if(base.empty()) {
+            const char* env = getenv("TMPDIR");
+            base = (env && *env) ? env : "/tmp";
+        }
+        string pattern = base + "/energy_barrier_XXXXXX";
+        vector<char> buffer(pattern.begin(), pattern.end());
+        buffer.push_back('\0');
+        if(!mkdtemp(buffer.data())) {
+            throw runtime_error("computeEnergyBarrierExternal: cannot create a scratch directory in " + base);
+        }
+        path = buffer.data();
+    }
+
+    ~ScratchDirectory() {
+        if(!persistent) discard();
+    }
+
+    string newFile() {
+        string file = fileOf("run" + to_string(counter++));
+        live.insert(file);
+        return file;
+    }
+
+    void removeFile(const string& file) {
+        live.erase(file);
+        if(protectedFiles.count(file)) obsolete.push_back(file);
+        else std::remove(file.c_str());
+    }
+
+    // 'files' now make up the latest checkpoint; delete the files only
+    // the previous one still held on to
+    void protect(const vector<string>& files) {
+        for(const string& file : obsolete) std::remove(file.c_str());
+        obsolete.clear();
+        protectedFiles = unordered_set<string>(files.begin(), files.end());
+    }
+
+    // Adopt the files of a checkpoint being resumed
+    void restore(const vector<string>& files, size_t nextCounter) {
+        live.insert(files.begin(), files.end());
+        protectedFiles = unordered_set<string>(files.begin(), files.end());
+        counter = nextCounter;
+    }
+
+    // Delete every run and checkpoint file, including ones left behind by
+    // an interrupted round (see isSearchFileName), and the directory
+    // itself if it is private
+    void discard() {
+        if(DIR* dir = opendir(path.c_str())) {
+            while(dirent* entry = readdir(dir)) {
+                string name = entry->d_name;
+                if(isSearchFileName(name)) {
+                    std::remove(fileOf(name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        live.clear();
+        obsolete.clear();
+        protectedFiles.clear();
+        if(!persistent) rmdir(path.c_str());
+    }
+
+    const string& directory() const { return path; }
+    string fileOf(const string& name) const { return path + "/" + name; }
+    string nameOf(const string& file) const { return file.substr(path.size() + 1); }
+    size_t fileCounter() const { return counter; }
+
+private:
+    string path;
+    bool persistent = false;
+    unordered_set<string> live;
+    unordered_set<string> protectedFiles;
+    vector<string> obsolete;
+    size_t counter = 0;
+};
+
+static FILE* openRunFile(const string& file, const char* mode) {
+    FILE* f = fopen(file.c_str(), mode);
+    if(!f) throw runtime_error("computeEnergyBarrierExternal: cannot open " + file);
+    setvbuf(f, nullptr, _IOFBF, runBufferBytes);
+    return f;
+}
+
+/*
+ * Writer of a sorted run. Each state is stored as its difference from the
+ * previous one (from 0 for the first), in little-endian base-128 with the
+ * high bit of a byte marking that more bytes follow. Dense sorted runs
+ * have small gaps, so most states take a few bytes instead of 8W.
+ */
+template<int W>
+class RunWriter {
+public:
+    explicit RunWriter(const string& file) : name(file), f(openRunFile(file, "wb")) {}
+    ~RunWriter() { if(f) fclose(f); }
+
+    // x must be larger than the previously written state
+    void write(const FixedState<W>& x) {
+        FixedState<W> delta;
+        uint64_t borrow = 0;
+        for(int w = 0; w < W; w++) {
+            uint64_t diff = x[w] - prev[w];
+            uint64_t out = diff - borrow;
+            borrow = (x[w] < prev[w]) || (diff < borrow);
+            delta[w] = out;
+        }
+
+        bool more = true;
+        while(more) {
+            int byte = (int)(delta[0] & 0x7F);
+            for(int w = 0; w < W; w++) {
+                delta[w] >>= 7;
+                if(w + 1 < W) delta[w] |= delta[w + 1] << 57;
+            }
+            more = false;
+            for(int w = 0; w < W; w++) more |= delta[w] != 0;
+            if(more) byte |= 0x80;
+            putc(byte, f);
+        }
+        prev = x;
+        count++;
+    }
+
+    size_t size() const { return count; }
+    const string& file() const { return name; }
+
+    void close() {
+        bool failed = ferror(f) != 0;
+        failed |= fclose(f) != 0;
+        f = nullptr;
+        if(failed) throw runtime_error("computeEnergyBarrierExternal: cannot write " + name);
+    }
+
+private:
+    string name;
+    FILE* f;
+    FixedState<W> prev{};
+    size_t count = 0;
+};
+
+// Reader of a run written by RunWriter
+template<int W>
+class RunReader {
+public:
+    explicit RunReader(const string& file) : f(openRunFile(file, "rb")) {}
+    ~RunReader() { fclose(f); }
+
+    bool next(FixedState<W>& x) {
+        int c = getc(f);
+        if(c == EOF) return false;
+        FixedState<W> delta{};
+        for(int pos = 0; ; pos += 7) {
+            uint64_t bits = (uint64_t)(c & 0x7F);
+            int w = pos >> 6, off = pos & 63;
+            if(w < W) delta[w] |= bits << off;
+            if(off > 57 && w + 1 < W) delta[w + 1] |= bits >> (64 - off);
+            if(!(c & 0x80)) break;
+            c = getc(f);
+            if(c == EOF) throw runtime_error("computeEnergyBarrierExternal: truncated run file");
+        }
+
+        uint64_t carry = 0;
+        for(int w = 0; w < W; w++) {
+            uint64_t sum = prev[w] + delta[w];
+            uint64_t out = sum + carry;
+            carry = (sum < prev[w]) || (out < sum);
+            prev[w] = out;
+        }
+        x = prev;
+        return true;
+    }
+
+private:
+    FILE* f;
+    FixedState<W> prev{};
+};
+
+// Ascending union of several sorted runs, each state reported once
+template<int W>
+class MergedRuns {
+public:
+    explicit MergedRuns(const vector<string>& files) {
+        for(const string& file : files) {
+            readers.emplace_back(new RunReader<W>(file));
+            FixedState<W> x;
+            if(readers.back()->next(x)) heap.push({x, (int)readers.size() - 1});
+        }
+    }
+
+    bool next(FixedState<W>& x) {
+        while(!heap.empty()) {
+            Head top = heap.top();
+            heap.pop();
+            FixedState<W> following;
+            if(readers[top.reader]->next(following)) heap.push({following, top.reader});
+            if(hasLast && top.state == last) continue;
+            last = top.state;
+            hasLast = true;
+            x = top.state;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Head {
+        FixedState<W> state;
+        int reader;
+        bool operator<(const Head& other) const { return stateLess<W>(other.state, state); }
+    };
+
+    vector<unique_ptr<RunReader<W>>> readers;
+    priority_queue<Head> heap;
+    FixedState<W> last{};
+    bool hasLast = false;
+};
+
+// Identifies a checkpoint file format
+static const char checkpointMagic[8] = {'E', 'B', 'X', 'C', 'K', 'P', 'T', '1'};
+
+/*
+ * Hash of H and c_target stored in a checkpoint, so a checkpoint is never
+ * resumed for a different problem.
+ */
+static uint64_t problemFingerprint(const ParityCheckMatrix& H, const vector<int>& c_target) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    auto mixIn = [&](uint64_t v) {
+        h ^= v;
+        h *= 0x100000001B3ULL;
+        h ^= h >> 29;
+    };
+    mixIn((uint64_t)H.rows());
+    mixIn((uint64_t)H.cols());
+    for(int r = 0; r < H.rows(); r++) {
+        mixIn(0xFFFFFFFFULL);
+        for(int c : H.row(r)) mixIn((uint64_t)c);
+    }
+    for(int bit : c_target) mixIn((uint64_t)(bit & 1));
+    return h;
+}
+
+static void writeWord(FILE* f, uint64_t v) {
+    fwrite(&v, sizeof(v), 1, f);
+}
+
+static uint64_t readWord(FILE* f) {
+    uint64_t v;
+    if(fread(&v, sizeof(v), 1, f) != 1) {
+        throw runtime_error("resumeEnergyBarrierExternal: truncated checkpoint");
+    }
+    return v;
+}
+
+template<int W>
+class ExternalBarrierSearch {
+public:
+    ExternalBarrierSearch(const ParityCheckMatrix& H, const vector<int>& c_target,
+                          const ExternalSearchConfig& config)
+        : H(H), config(config), scratch(config.directory, config.checkpointDirectory),
+          fingerprint(problemFingerprint(H, c_target)), targetEnergy(energyOfState(H, c_target)),
+          PH(H.toPacked()), pending(H.rows() + 1) {
+        for(int c = 0; c < H.cols(); c++) {
+            if(c_target[c] & 1) flipBit(target.data(), c);
+        }
+    }
+
+    // Search from the zero state
+    int run() {
+        FixedState<W> zero{};
+        if(target == zero) return 0;
+        if(checkpointing()) scratch.discard();  // files of an earlier search
+        level = 0;
+        vector<FixedState<W>> start = {zero};
+        pending[0].push_back(writeRun(start));
+        visitedRuns.push_back(writeRun(start));
+        return search();
+    }
+
+    // Search from the checkpoint in config.checkpointDirectory
+    int resume() {
+        loadCheckpoint();
+        return search();
+    }
+
+private:
+    bool checkpointing() const { return !config.checkpointDirectory.empty(); }
+
+    int search() {
+        auto lastCheckpoint = chrono::steady_clock::now();
+        for(; level <= H.rows(); level++) {
+            if(frontier.empty()) frontier.swap(pending[level]);
+            while(!frontier.empty()) {
+                if(checkpointing()) {
+                    auto now = chrono::steady_clock::now();
+                    if(chrono::duration<double>(now - lastCheckpoint).count() >= config.checkpointInterval) {
+                        writeCheckpoint();
+                        lastCheckpoint = now;
+                    }
+                }
+                if(round()) return finished(max(level, targetEnergy));
+            }
+        }
+        return finished(-1);
+    }
+
+    // Checkpoint files are no longer needed once the result is known
+    int finished(int result) {
+        if(checkpointing()) scratch.discard();
+        return result;
+    }
+
+    /*
+     * Expand the current frontier once. New states go to the visited runs
+     * and to the next frontier or a higher level; returns true if the
+     * target was among them.
+     */
+    bool round() {
+        vector<string> candidates = expand(frontier);
+        frontier.clear();
+
+        // Candidates minus visited: the new states of this round
+        MergedRuns<W> fresh(candidates), seen(visitedRuns);
+        RunWriter<W> added(scratch.newFile()), sameLevel(scratch.newFile());
+        vector<unique_ptr<RunWriter<W>>> higher(H.rows() + 1);
+
+        // New states wait in 'block' until their energies are known;
+        // routing keeps every run ascending
+        vector<FixedState<W>> block;
+        vector<int> energies;
+        auto route = [&]() {
+            scoreBlock(block, energies);
+            for(size_t k = 0; k < block.size(); k++) {
+                int e = energies[k];
+                if(e <= level) {
+                    sameLevel.write(block[k]);
+                } else {
+                    if(!higher[e]) higher[e].reset(new RunWriter<W>(scratch.newFile()));
+                    higher[e]->write(block[k]);
+                }
+            }
+            block.clear();
+        };
+
+        FixedState<W> x, v;
+        bool hasSeen = seen.next(v);
+        while(fresh.next(x)) {
+            while(hasSeen && stateLess<W>(v, x)) hasSeen = seen.next(v);
+            if(hasSeen && v == x) continue;
+            if(x == target) return true;
+
+            added.write(x);
+            block.push_back(x);
+            if(block.size() == energyBatchStates) route();
+        }
+        route();
+        for(const string& file : candidates) scratch.removeFile(file);
+
+        string addedRun = finish(added);
+        if(!addedRun.empty()) visitedRuns.push_back(addedRun);
+        if((int)visitedRuns.size() > config.maxRuns) visitedRuns = {mergeRuns(visitedRuns)};
+        for(int e = level + 1; e <= H.rows(); e++) {
+            if(higher[e]) pending[e].push_back(finish(*higher[e]));
+        }
+        string next = finish(sameLevel);
+        if(!next.empty()) frontier.push_back(next);
+        return false;
+    }
+
+    /*
+     * Checkpoint = the run lists (frontier, visited, one per higher level)
+     * plus the current level. The runs are immutable files, so only this
+     * small index is written: to a temporary file, then renamed over the
+     * previous checkpoint. To survive a host crash, not just a killed
+     * process, every referenced run not yet synced, the index and the
+     * directory entries are fsynced before the rename, and the directory
+     * again after it.
+     */
+    void writeCheckpoint() {
+        string file = scratch.fileOf("checkpoint");
+        string temporary = file + ".tmp";
+        FILE* f = fopen(temporary.c_str(), "wb");
+        if(!f) throw runtime_error("computeEnergyBarrierExternal: cannot write " + temporary);
+
+        vector<string> referenced;
+        auto writeList = [&](const vector<string>& runs) {
+            writeWord(f, runs.size());
+            for(const string& run : runs) {
+                string name = scratch.nameOf(run);
+                writeWord(f, name.size());
+                fwrite(name.data(), 1, name.size(), f);
+                referenced.push_back(run);
+            }
+        };
+        fwrite(checkpointMagic, 1, sizeof(checkpointMagic), f);
+        writeWord(f, fingerprint);
+        writeWord(f, W);
+        writeWord(f, level);
+        writeWord(f, scratch.fileCounter());
+        writeList(frontier);
+        writeList(visitedRuns);
+        for(const vector<string>& runs : pending) writeList(runs);
+
+        bool failed = fflush(f) != 0 || fsync(fileno(f)) != 0 || ferror(f) != 0;
+        failed |= fclose(f) != 0;
+
+        unordered_set<string> synced;
+        for(const string& run : referenced) {
+            if(!syncedRuns.count(run) && !syncPath(run)) {
+                throw runtime_error("computeEnergyBarrierExternal: cannot sync " + run);
+            }
+            synced.insert(run);
+        }
+        failed |= !syncPath(scratch.directory());
+        if(failed || rename(temporary.c_str(), file.c_str()) != 0 || !syncPath(scratch.directory())) {
+            throw runtime_error("computeEnergyBarrierExternal: cannot write " + file);
+        }
+        syncedRuns.swap(synced);
+        scratch.protect(referenced);
+    }
+
+    void loadCheckpoint() {
+        string file = scratch.fileOf("checkpoint");
+        FILE* f = fopen(file.c_str(), "rb");
+        if(!f) throw runtime_error("resumeEnergyBarrierExternal: no checkpoint in " + config.checkpointDirectory);
+        unique_ptr<FILE, int (*)(FILE*)> closer(f, fclose);
+
+        char magic[sizeof(checkpointMagic)];
+        if(fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+           !equal(magic, magic + sizeof(magic), checkpointMagic)) {
+            throw runtime_error("resumeEnergyBarrierExternal: " + file + " is not a checkpoint");
+        }
+        if(readWord(f) != fingerprint || readWord(f) != (uint64_t)W) {
+            throw invalid_argument("resumeEnergyBarrierExternal: the checkpoint belongs to a different code or target");
+        }
+        level = (int)readWord(f);
+        size_t counter = readWord(f);
+
+        vector<string> referenced;
+        auto readList = [&]() {
+            vector<string> runs(readWord(f));
+            for(string& run : runs) {
+                string name(readWord(f), '\0');
+                if(fread(&name[0], 1, name.size(), f) != name.size()) {
+                    throw runtime_error("resumeEnergyBarrierExternal: truncated checkpoint");
+                }
+                run = scratch.fileOf(name);
+                referenced.push_back(run);
+            }
+            return runs;
+        };
+        frontier = readList();
+        visitedRuns = readList();
+        for(vector<string>& runs : pending) runs = readList();
+        scratch.restore(referenced, counter);
+        syncedRuns = unordered_set<string>(referenced.begin(), referenced.end());
+    }
+
+    // Energy of x from the columns of its set bits
+    int energyOf(const FixedState<W>& x) const {
+        FixedState<W> syndrome{};
+        for(int c = 0; c < H.cols(); c++) {
+            if(!getBit(x.data(), c)) continue;
+            for(int r : H.col(c)) flipBit(syndrome.data(), r);
+        }
+        int energy = 0;
+        for(uint64_t w : syndrome) energy += __builtin_popcountll(w);
+        return energy;
+    }
+
+    /*
+     * energies[k] = E(block[k]). Blocks of at least minEnergyBatch states
+     * go through the bit-sliced batch kernel (gf2_batch.hpp), which shares
+     * the cost of each row of H across all lanes.
+     */
+    void scoreBlock(const vector<FixedState<W>>& block, vector<int>& energies) const {
+        energies.resize(block.size());
+        if(block.size() < minEnergyBatch) {
+            for(size_t k = 0; k < block.size(); k++) energies[k] = energyOf(block[k]);
+            return;
+        }
+        const int words = PH.wordsPerRow;
+        vector<uint64_t> states(block.size() * words);
+        for(size_t k = 0; k < block.size(); k++) {
+            copy_n(block[k].begin(), words, states.begin() + k * words);
+        }
+        energyOfStatesBatch(PH, states.data(), block.size(), energies.data());
+    }
+
+    // Close a run; returns its file, or "" (file removed) if it is empty
+    string finish(RunWriter<W>& writer) {
+        writer.close();
+        if(writer.size() > 0) return writer.file();
+        scratch.removeFile(writer.file());
+        return "";
+    }
+
+    // Sort and deduplicate states in place and write them as a new run
+    string writeRun(vector<FixedState<W>>& states) {
+        sort(states.begin(), states.end(), stateLess<W>);
+        states.erase(unique(states.begin(), states.end()), states.end());
+        RunWriter<W> writer(scratch.newFile());
+        for(const FixedState<W>& x : states) writer.write(x);
+        writer.close();
+        return writer.file();
+    }
+
+    // Merge runs into one (deleting them) and return it
+    string mergeRuns(const vector<string>& runs) {
+        RunWriter<W> writer(scratch.newFile());
+        {
+            MergedRuns<W> merged(runs);
+            FixedState<W> x;
+            while(merged.next(x)) writer.write(x);
+        }
+        writer.close();
+        for(const string& file : runs) scratch.removeFile(file);
+        return writer.file();
+    }
+
+    /*
+     * Neighbours of every frontier state, as at most maxRuns sorted runs.
+     * The frontier files are deleted once read; the buffer grows as
+     * needed up to the memory budget, is spilled when full and reused.
+     */
+    vector<string> expand(const vector<string>& frontier) {
+        size_t capacity = max(config.memoryBudget / sizeof(FixedState<W>), (size_t)H.cols());
+        vector<FixedState<W>> buffer;
+        vector<string> runs;
+        auto spill = [&]() {
+            if(buffer.empty()) return;
+            runs.push_back(writeRun(buffer));
+            buffer.clear();
+        };
+
+        for(const string& file : frontier) {
+            {
+                RunReader<W> reader(file);
+                FixedState<W> x;
+                while(reader.next(x)) {
+                    if(buffer.size() + H.cols() > capacity) spill();
+                    // Double as usual, but never past the budget
+                    if(buffer.size() + H.cols() > buffer.capacity()) {
+                        buffer.reserve(min(capacity, max(2 * buffer.capacity(), buffer.size() + H.cols())));
+                    }
+                    for(int i = 0; i < H.cols(); i++) {
+                        buffer.push_back(x);
+                        flipBit(buffer.back().data(), i);
+                    }
+                }
+            }
+            scratch.removeFile(file);
+        }
+        spill();
+
+        // Merge passes over groups of maxRuns runs, as in an external sort
+        while((int)runs.size() > config.maxRuns) {
+            vector<string> merged;
+            for(size_t k = 0; k < runs.size(); k += config.maxRuns) {
+                size_t end = min(runs.size(), k + (size_t)config.maxRuns);
+                merged.push_back(mergeRuns(vector<string>(runs.begin() + k, runs.begin() + end)));
+            }
+            runs.swap(merged);
+        }
+        return runs;
+    }
+
+    const ParityCheckMatrix& H;
+    const ExternalSearchConfig& config;
+    ScratchDirectory scratch;
+    uint64_t fingerprint;
+    FixedState<W> target{};
+    int targetEnergy;
+    PackedMatrix PH;    // H for energyOfStatesBatch
+
+    // Search state, as saved in a checkpoint
+    int level = 0;
+    vector<string> frontier;
+    vector<string> visitedRuns;
+    vector<vector<string>> pending;   // runs waiting for each higher level
+    unordered_set<string> syncedRuns; // runs of the last checkpoint, already on disk
+};
+
+template<int W>
+static int externalSearchFixed(const ParityCheckMatrix& H, const vector<int>& c_target,
+                               const ExternalSearchConfig& config, bool resume) {
+    ExternalBarrierSearch<W> search(H, c_target, config);
+    return resume ? search.resume() : search.run();
+}
+
+static int externalSearch(const ParityCheckMatrix& H, const vector<int>& c_target,
+                          const ExternalSearchConfig& config, bool resume, const char* caller) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument(string(caller) + ": c_target length does not match H");
+    }
+    if(config.maxRuns < 2) {
+        throw invalid_argument(string(caller) + ": maxRuns must be at least 2");
+    }
+
+    return withStateWidth(max(H.cols(), H.rows()), caller, [&](auto w) {
+        return externalSearchFixed<decltype(w)::value>(H, c_target, config, resume);
+    });
+}
+
+int computeEnergyBarrierExternal(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                 const ExternalSearchConfig& config) {
+    // A fresh search clears the directory's run files, which would lose
+    // the checkpoint of an interrupted search
+    if(!config.checkpointDirectory.empty() && externalCheckpointExists(config.checkpointDirectory)) {
+        throw runtime_error("computeEnergyBarrierExternal: " + config.checkpointDirectory +
+                            " holds a checkpoint; continue it with resumeEnergyBarrierExternal or delete it first");
+    }
+    return externalSearch(H, c_target, config, false, "computeEnergyBarrierExternal");
+}
+
+int computeEnergyBarrierExternal(const vector<vector<int>>& H, const vector<int>& c_target,
+                                 const ExternalSearchConfig& config) {
+    return computeEnergyBarrierExternal(ParityCheckMatrix(H), c_target, config);
+}
+
+bool externalCheckpointExists(const string& checkpointDirectory) {
+    return access((checkpointDirectory + "/checkpoint").c_str(), R_OK) == 0;
+}
+
+int resumeEnergyBarrierExternal(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                const ExternalSearchConfig& config) {
+    if(config.checkpointDirectory.empty()) {
+        throw invalid_argument("resumeEnergyBarrierExternal: config.checkpointDirectory is not set");
+    }
+    bool zeroTarget = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(zeroTarget && (int)c_target.size() == H.cols()) return 0;
+    return externalSearch(H, c_target, config, true, "resumeEnergyBarrierExternal");
+}
+
+int resumeEnergyBarrierExternal(const vector<vector<int>>& H, const vector<int>& c_target,
+                                const ExternalSearchConfig& config) {
+    return resumeEnergyBarrierExternal(ParityCheckMatrix(H), c_target, config);
+}
@@ -0,0 +1,123 @@
+#include "../include/energy_barrier_parallel.hpp"
+#include "../include/energy_barrier.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/search_structures.hpp"
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <omp.h>
+using namespace std;
+
+// A frontier state with its syndrome and energy
+template<int W>
+struct FrontierNode {
+    FixedState<W> x;
+    FixedState<W> syndrome;
+    int energy;
+};
+
+// New states found by one thread during one round
+template<int W>
+struct RoundOutput {
+    vector<FrontierNode<W>> sameLevel;                  // energy <= current level
+    vector<pair<int, FrontierNode<W>>> higherLevel;    // (peak, state)
+};
+
+template<int W, class Visited>
+static int parallelSearchFixed(const ParityCheckMatrix& H, const FixedState<W>& target,
+                               int targetEnergy, Visited& visited, int threads) {
+    int n = H.cols();
+    FixedState<W> zero{};
+    visited.insert(zero.data());
+    if(target == zero) return 0;
+
+    vector<vector<FrontierNode<W>>> pending(H.rows() + 1);
+    pending[0].push_back({zero, zero, 0});
+    vector<RoundOutput<W>> outputs(threads);
+
+    for(int level = 0; level <= H.rows(); level++) {
+        vector<FrontierNode<W>> frontier;
+        frontier.swap(pending[level]);
+        while(!frontier.empty()) {
+            atomic<bool> found{false};
+
+            #pragma omp parallel num_threads(threads)
+            {
+                RoundOutput<W>& out = outputs[omp_get_thread_num()];
+                #pragma omp for schedule(dynamic, 64)
+                for(size_t k = 0; k < frontier.size(); k++) {
+                    if(found.load(memory_order_relaxed)) continue;
+                    const FrontierNode<W>& curr = frontier[k];
+                    for(int i = 0; i < n; i++) {
+                        FrontierNode<W> next;
+                        next.x = curr.x;
+                        flipBit(next.x.data(), i);
+                        if(!visited.insert(next.x.data())) continue;
+
+                        next.energy = curr.energy + flipEnergyDelta(H.col(i), curr.syndrome.data());
+                        if(next.x == target) {
+                            found = true;
+                            break;
+                        }
+                        next.syndrome = curr.syndrome;
+                        for(int r : H.col(i)) flipBit(next.syndrome.data(), r);
+                        if(next.energy <= level) out.sameLevel.push_back(next);
+                        else out.higherLevel.push_back({next.energy, next});
+                    }
+                }
+            }
+
+            // The target's peak is max(level, E(target)) whichever thread
+            // reached it
+            if(found) return max(level, targetEnergy);
+
+            frontier.clear();
+            for(RoundOutput<W>& out : outputs) {
+                frontier.insert(frontier.end(), out.sameLevel.begin(), out.sameLevel.end());
+                for(auto& item : out.higherLevel) pending[item.first].push_back(item.second);
+                out.sameLevel.clear();
+                out.higherLevel.clear();
+            }
+        }
+    }
+    return -1;
+}
+
+template<int W>
+static int computeEnergyBarrierParallelFixed(const ParityCheckMatrix& H, const vector<int>& c_target,
+                                             int threads) {
+    int n = H.cols();
+    FixedState<W> target{};
+    for(int c = 0; c < n; c++) {
+        if(c_target[c] & 1) flipBit(target.data(), c);
+    }
+
+    int targetEnergy = energyOfState(H, c_target);
+
+    bool dense = n <= maxDenseVisitedBits() &&
+                 (visitedStorage() == VisitedStorage::Dense ||
+                  (visitedStorage() == VisitedStorage::Auto &&
+                   AtomicVisitedBits::bytesFor(n) <= denseVisitedBudget()));
+    if(dense) {
+        AtomicVisitedBits visited(n);
+        return parallelSearchFixed<W>(H, target, targetEnergy, visited, threads);
+    }
+    ShardedVisitedSet<W> visited;
+    return parallelSearchFixed<W>(H, target, targetEnergy, visited, threads);
+}
+
+int computeEnergyBarrierParallel(const ParityCheckMatrix& H, const vector<int>& c_target, int threads) {
+    if((int)c_target.size() != H.cols()) {
+        throw invalid_argument("computeEnergyBarrierParallel: c_target length does not match H");
+    }
+    if(threads <= 0) threads = omp_get_max_threads();
+
+    return withStateWidth(max(H.cols(), H.rows()), "computeEnergyBarrierParallel", [&](auto w) {
+        return computeEnergyBarrierParallelFixed<decltype(w)::value>(H, c_target, threads);
+    });
+}
+
+int computeEnergyBarrierParallel(const vector<vector<int>>& H, const vector<int>& c_target, int threads) {
+    return computeEnergyBarrierParallel(ParityCheckMatrix(H), c_target, threads);
+}
@@ -5,6 +5,9 @@
 #include <string>
 #include <random>
 #include <numeric>
+#include "../include/gf2_packed.hpp"
+#include "../include/parity_check_matrix.hpp"
+#include "../include/search_limits.hpp"
 using namespace std;
 
 // Helper function to count 1-bits in an integer (mod 2)
@@ -24,206 +27,101 @@ string vectorToString(const vector<int>& vec) {
 
 // Gaussian Elimination (over GF(2)) to find the RREF of H
 // Returns a tuple: (H in RREF, pivotCols, rank)
+// The elimination itself runs on the bit-packed form (see gf2_packed.hpp).
 tuple<vector<vector<int>>, vector<int>, int> 
 gaussianEliminationGF2(const vector<vector<int>>& H_in) {
-    // Make a local copy so we don't destroy the input
-    vector<vector<int>> H(H_in);
-    int rows = (int)H.size();
-    int cols = (rows == 0) ? 0 : (int)H[0].size();
-
-    int pivotRow = 0;
-    vector<int> pivotCols;  // store pivot column indices
-
-    for (int col = 0; col < cols && pivotRow < rows; col++) {
-        // Find pivot (row with a '1' in the current column)
-        int pivotCandidate = -1;
-        for (int r = pivotRow; r < rows; r++) {
-            if (H[r][col] == 1) {
-                pivotCandidate = r;
-                break;
-            }
-        }
-        if (pivotCandidate == -1) {
-            continue; // no pivot in this column
-        }
-
-        // Swap pivotCandidate row into pivotRow
-        if (pivotCandidate != pivotRow) {
-            swap(H[pivotRow], H[pivotCandidate]);
-        }
-        pivotCols.push_back(col);
-
-        // Eliminate below pivotRow
-        for (int r = pivotRow + 1; r < rows; r++) {
-            if (H[r][col] == 1) {
-                // XOR row pivotRow into row r
-                for (int c = col; c < cols; c++) {
-                    H[r][c] ^= H[pivotRow][c];
-                }
-            }
-        }
-        pivotRow++;
-    }
-    int rank = pivotRow;
-
-    // Convert to Reduced Row Echelon Form (RREF) by eliminating above pivots
-    for (int i = rank - 1; i >= 0; i--) {
-        int pivotCol = pivotCols[i];
-        // pivot is at row i, col pivotCol
-        // Eliminate above
-        for (int r = i - 1; r >= 0; r--) {
-            if (H[r][pivotCol] == 1) {
-                for (int c = pivotCol; c < cols; c++) {
-                    H[r][c] ^= H[i][c];
-                }
-            }
-        }
-    }
-
-    return make_tuple(H, pivotCols, rank);
+    auto [R, pivotCols, rank] = gaussianEliminationGF2Packed(packMatrix(H_in));
+    return make_tuple(unpackMatrix(R), pivotCols, rank);
 }
 
 /*
- * Find a single non-trivial codeword in the null space of H
- * Input: H is an ℓ x n parity-check matrix over GF(2)
- * Output: A vector representing a non-zero codeword, or empty vector if none exists
+ * Null-space vector obtained from the RREF by setting free column fc to 1:
+ * the pivot variable of row i is then RREF[i][fc], every other free
+ * variable is 0.
  */
-vector<int> findSingleCodeword(const vector<vector<int>>& H) {
-    if (H.empty()) {
-        return vector<int>(0, 0);  // Return zero vector of size 0
-    }
-
-    int cols = (int)H[0].size();
-
-    // 1) Compute RREF of H
-    auto [RREF, pivotCols, rank] = gaussianEliminationGF2(H);
-
-    // If rank equals number of columns, only the zero vector exists
-    if (rank == cols) {
-        return vector<int>(cols, 0);  // Return zero vector of size cols
+static PackedState nullVectorForFreeColumn(const PackedMatrix& RREF,
+                                           const vector<int>& pivotCols, int fc) {
+    PackedState v(RREF.wordsPerRow, 0);
+    flipBit(v.data(), fc);
+    for (int pivot_i = 0; pivot_i < (int)pivotCols.size(); pivot_i++) {
+        if (RREF.get(pivot_i, fc)) flipBit(v.data(), pivotCols[pivot_i]);
     }
+    return v;
+}
 
-    // Find a free column (first column that's not a pivot)
-    vector<bool> isPivot(cols, false);
+// Columns of the RREF that carry no pivot
+static vector<int> freeColumns(int cols, const vector<int>& pivotCols) {
+    vector<int> isPivot(cols, 0);
     for (int pc : pivotCols) {
-        isPivot[pc] = true;
+        isPivot[pc] = 1;
     }
-    
-    int freeCol = -1;
+    vector<int> freeCols;
     for (int c = 0; c < cols; c++) {
-        if (!isPivot[c]) {
-            freeCol = c;
-            break;
-        }
+        if (!isPivot[c]) freeCols.push_back(c);
     }
+    return freeCols;
+}
 
-    // Create a codeword by setting the free variable to 1
-    vector<int> codeword(cols, 0);
-    codeword[freeCol] = 1;
+// findSingleCodeword on a packed H
+static vector<int> findSingleCodewordPacked(const PackedMatrix& PH) {
+    int cols = PH.cols;
 
-    // Solve for pivot variables using RREF
-    for (int pivot_i = 0; pivot_i < (int)pivotCols.size(); pivot_i++) {
-        int pcol = pivotCols[pivot_i];
-        // The pivot is in row pivot_i
-        int sum = 0;
-        for (int c = 0; c < cols; c++) {
-            if (c != pcol && RREF[pivot_i][c] == 1) {
-                sum ^= codeword[c];
-            }
-        }
-        codeword[pcol] = sum;
+    // 1) Compute RREF of H
+    auto [RREF, pivotCols, rank] = gaussianEliminationGF2Packed(PH);
+
+    // If rank equals number of columns, only the zero vector exists
+    if (rank == cols) {
+        return vector<int>(cols, 0);  // Return zero vector of size cols
     }
 
-    return codeword;
+    // Set the first free column to 1 and solve for the pivot variables
+    int freeCol = freeColumns(cols, pivotCols)[0];
+    return unpackState(nullVectorForFreeColumn(RREF, pivotCols, freeCol), cols);
 }
 
-/*
- * ComputeAllCodewordsGF2(H):
- *   Input: H is an ℓ x n parity-check matrix over GF(2).
- *   Output: A vector of binary strings, each representing one codeword in the null space of H.
- */
-vector<string> computeAllCodewordsGF2(const vector<vector<int>>& H) {
-    if (H.empty()) {
-        // Edge case: no parity checks -> all 2^n strings are valid
-        // But we don't know n from H. Return empty or handle differently.
-        return {"0"}; // minimal placeholder
-    }
-
-//    int rows = (int)H.size();
-    int cols = (int)H[0].size();
+// computeAllCodewordsGF2 on a packed H
+// With a tracker, each codeword listed is one unit of work and listing
+// stops (leaving a partial list) once it expires
+static vector<string> computeAllCodewordsPacked(const PackedMatrix& PH, LimitTracker* tracker = nullptr) {
+    int cols = PH.cols;
 
     // 1) Compute RREF of H
-    auto [RREF, pivotCols, rank] = gaussianEliminationGF2(H);
-
-    // pivotCols: columns where we have pivots
-    // freeCols: columns that are not in pivotCols
-    vector<int> freeCols;
-    {
-        vector<int> isPivot(cols, 0);
-        for (int pc : pivotCols) {
-            isPivot[pc] = 1;
-        }
-        for (int c = 0; c < cols; c++) {
-            if (!isPivot[c]) freeCols.push_back(c);
-        }
-    }
+    auto [RREF, pivotCols, rank] = gaussianEliminationGF2Packed(PH);
 
     // The dimension of the code = # of free columns = k
+    vector<int> freeCols = freeColumns(cols, pivotCols);
     int k = (int)freeCols.size();
 
     // If the code is the zero code (rank = n), then only codeword is the zero vector
     if (k == 0) {
-        // Check if the zero vector indeed satisfies Hx=0 (it does).
+        if (tracker && tracker->expired()) return {};
         return {string(cols, '0')};
     }
 
-    // 2) For each free column, create a basis vector that sets that free col=1, others=0,
-    //    then solve for pivot columns using RREF relationships.
-
-    vector<vector<int>> basis; // each basis vector is length 'cols'
+    // 2) One basis vector per free column, solved from the RREF
+    vector<PackedState> basis;
     basis.reserve(k);
-
-    for (int i = 0; i < k; i++) {
-        vector<int> v(cols, 0);
-        // set the i-th free column to 1
-        int fc = freeCols[i];
-        v[fc] = 1;
-
-        // Solve pivot variables from RREF
-        // If row i has a pivot in pivotCols[i], that row implies pivot variable = sum of free variables
-        for (int pivot_i = 0; pivot_i < (int)pivotCols.size(); pivot_i++) {
-            int pcol = pivotCols[pivot_i];
-            // The pivot is in row pivot_i. The row is RREF[pivot_i].
-            int sumFree = 0;
-            for (int c : freeCols) {
-                if (RREF[pivot_i][c] == 1) {
-                    sumFree ^= v[c];
-                }
-            }
-            // pivot variable = sumFree to satisfy Hx=0
-            v[pcol] = sumFree;
-        }
-
-        basis.push_back(v);
+    for (int fc : freeCols) {
+        basis.push_back(nullVectorForFreeColumn(RREF, pivotCols, fc));
     }
 
-    // 3) Enumerate all linear combinations of the k basis vectors
+    // 3) Enumerate all 2^k combinations in Gray-code order, so consecutive
+    //    codewords differ by a single packed basis vector XOR
     vector<string> allCodewords;
-    allCodewords.reserve((size_t)1 << k);
-
-    // We'll generate every 0/1 combination of these k basis vectors
-    for (int mask = 0; mask < (1 << k); mask++) {
-        vector<int> codeword(cols, 0);
-        // Combine basis vectors according to bits in 'mask'
-        for (int b = 0; b < k; b++) {
-            if ((mask >> b) & 1) {
-                // XOR basis[b] into codeword
-                for (int c = 0; c < cols; c++) {
-                    codeword[c] ^= basis[b][c];
-                }
+    if (!tracker) allCodewords.reserve((size_t)1 << k);
+
+    PackedState codeword(PH.wordsPerRow, 0);
+    string s(cols, '0');
+    for (long long step = 0; step < (1LL << k); step++) {
+        if (tracker && tracker->expired()) break;
+        if (step > 0) {
+            int b = __builtin_ctzll((unsigned long long)step);
+            for (int w = 0; w < PH.wordsPerRow; w++) {
+                codeword[w] ^= basis[b][w];
             }
         }
-        allCodewords.push_back(vectorToString(codeword));
+        packedToBitString(codeword.data(), cols, &s[0]);
+        allCodewords.push_back(s);
     }
 
     // Optional: sort allCodewords lexicographically
@@ -232,6 +130,48 @@ vector<string> computeAllCodewordsGF2(const vector<vector<int>>& H) {
     return allCodewords;
 }
 
+/*
+ * Find a single non-trivial codeword in the null space of H
+ * Input: H is an ℓ x n parity-check matrix over GF(2)
+ * Output: A vector representing a non-zero codeword, or empty vector if none exists
+ */
+vector<int> findSingleCodeword(const vector<vector<int>>& H) {
+    if (H.empty()) {
+        return vector<int>(0, 0);  // Return zero vector of size 0
+    }
+    return findSingleCodewordPacked(packMatrix(H));
+}
+
+vector<int> findSingleCodeword(const ParityCheckMatrix& H) {
+    return findSingleCodewordPacked(H.toPacked());
+}
+
+/*
+ * ComputeAllCodewordsGF2(H):
+ *   Input: H is an ℓ x n parity-check matrix over GF(2).
+ *   Output: A vector of binary strings, each representing one codeword in the null space of H.
+ */
+vector<string> computeAllCodewordsGF2(const vector<vector<int>>& H) {
+    if (H.empty()) {
+        // Edge case: no parity checks -> all 2^n strings are valid
+        // But we don't know n from H. Return empty or handle differently.
+        return {"0"}; // minimal placeholder
+    }
+    return computeAllCodewordsPacked(packMatrix(H));
+}
+
+vector<string> computeAllCodewordsGF2(const ParityCheckMatrix& H) {
+    return computeAllCodewordsPacked(H.toPacked());
+}
+
+vector<string> computeAllCodewordsGF2(const ParityCheckMatrix& H, const SearchLimits& limits,
+                                      SearchStatus& status) {
+    LimitTracker tracker(limits);
+    vector<string> codewords = computeAllCodewordsPacked(H.toPacked(), &tracker);
+    status = tracker.status();
+    return codewords;
+}
+
 // Add this function to src/generate_codeword.cpp
 
 /*
@@ -245,18 +185,8 @@ int hammingWeight(const string& s) {
     return weight;
 }
 
-/*
- * Compute the minimum Hamming distance of the code
- * The minimum distance is the minimum weight of any non-zero codeword
- * Returns:
- * - The minimum Hamming distance
- * - Returns -1 if the code contains only the zero codeword
- */
-int computeMinimumDistance(const vector<vector<int>>& H) {
-    // Get all codewords
-    vector<string> codewords = computeAllCodewordsGF2(H);
-    
-    // Find minimum weight of non-zero codewords
+// Minimum weight over the non-zero codewords, or -1 if there are none
+static int minimumNonZeroWeight(const vector<string>& codewords) {
     int minWeight = -1;  // -1 indicates no non-zero codeword found yet
     
     for (const string& codeword : codewords) {
@@ -271,51 +201,49 @@ int computeMinimumDistance(const vector<vector<int>>& H) {
     return minWeight;  // Will be -1 if only zero codeword exists
 }
 
+/*
+ * Compute the minimum Hamming distance of the code
+ * The minimum distance is the minimum weight of any non-zero codeword
+ * Returns:
+ * - The minimum Hamming distance
+ * - Returns -1 if the code contains only the zero codeword
+ */
+int computeMinimumDistance(const vector<vector<int>>& H) {
+    return minimumNonZeroWeight(computeAllCodewordsGF2(H));
+}
+
+int computeMinimumDistance(const ParityCheckMatrix& H) {
+    return minimumNonZeroWeight(computeAllCodewordsGF2(H));
+}
+
+int computeMinimumDistance(const ParityCheckMatrix& H, const SearchLimits& limits, SearchStatus& status) {
+    return minimumNonZeroWeight(computeAllCodewordsGF2(H, limits, status));
+}
+
 /* 
  * Compute the rank of a matrix over GF(2)
  * Input: mat is an m x n matrix over GF(2)
  * Output: The rank of mat over GF(2)
 */
 int computeRankGF2(vector<vector<int>>& mat) {
-    int m = (int)mat.size();
-    if (m == 0) return 0;
-    int n = (int)mat[0].size();
-
-    int rank = 0;
-    int row = 0;
-
-    for (int col = 0; col < n && row < m; col++) {
-        // Find pivot row with a 1 in this column, starting from 'row'
-        int pivot = row;
-        while (pivot < m && mat[pivot][col] == 0) {
-            pivot++;
-        }
-        // If no pivot in this column, continue to next column
-        if (pivot == m) continue;
-
-        // Swap pivot row with current row if needed
-        if (pivot != row) {
-            swap(mat[pivot], mat[row]);
-        }
+    if (mat.empty()) return 0;
 
-        // Eliminate below and above
-        for (int r = 0; r < m; r++) {
-            if (r != row && mat[r][col] == 1) {
-                // XOR row 'r' with row 'row'
-                for (int c = col; c < n; c++) {
-                    mat[r][c] ^= mat[row][c];
-                }
-            }
-        }
-        row++;
-        rank++;
-    }
+    // Reduce on packed rows and write the RREF back, as callers may rely on
+    // mat being left in reduced form.
+    auto [R, pivotCols, rank] = gaussianEliminationGF2Packed(packMatrix(mat));
+    mat = unpackMatrix(R);
     return rank;
 }
 
+int computeRankGF2(const ParityCheckMatrix& mat) {
+    return get<2>(gaussianEliminationGF2Packed(mat.toPacked()));
+}
+
 // Modified function to generate a random parity check matrix H (m x n)
 // with each row having at least 2 ones, and rank(H) < n over GF(2).
-vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
+// Rows are built as column lists with running column weights, so each row
+// costs O(n) instead of rescanning every earlier row.
+ParityCheckMatrix generateRandomSparseParityCheckMatrix(int m, int n, int w) {
     // Validate input parameters
     if (w < 2) w = 2;
     if (n < 2) throw invalid_argument("n must be at least 2");
@@ -327,8 +255,9 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
     const int MAX_ATTEMPTS = 100; // Maximum number of complete matrix generation attempts
     
     for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
-        // Initialize matrix with zeros
-        vector<vector<int>> H(m, vector<int>(n, 0));
+        // Column indices of the ones of each row, and current column weights
+        vector<vector<int>> rowCols(m);
+        vector<int> colWeight(n, 0);
         bool success = true;
 
         // For each row
@@ -345,11 +274,7 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
                 vector<int> valid_cols;
                 valid_cols.reserve(n);
                 for (int col = 0; col < n; col++) {
-                    int col_weight = 0;
-                    for (int r = 0; r < i; r++) {
-                        col_weight += H[r][col];
-                    }
-                    if (col_weight < w) {
+                    if (colWeight[col] < w) {
                         valid_cols.push_back(col);
                     }
                 }
@@ -363,17 +288,13 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
                 // Shuffle valid columns
                 shuffle(valid_cols.begin(), valid_cols.end(), gen);
 
-                // Clear current row
-                fill(H[i].begin(), H[i].end(), 0);
-
                 // Actual number of 1s to place in this row
                 int actual_weight = min(row_weight, (int)valid_cols.size());
                 actual_weight = max(2, actual_weight);  // Ensure at least 2 ones
 
                 // Place 1's in the selected positions
-                for (int j = 0; j < actual_weight; j++) {
-                    H[i][valid_cols[j]] = 1;
-                }
+                rowCols[i].assign(valid_cols.begin(), valid_cols.begin() + actual_weight);
+                for (int col : rowCols[i]) colWeight[col]++;
 
                 row_success = true;
                 break;
@@ -386,37 +307,51 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
         }
 
         if (success) {
+            auto toMatrix = [&]() {
+                vector<pair<int,int>> entries;
+                for (int i = 0; i < m; i++) {
+                    for (int col : rowCols[i]) entries.push_back({i, col});
+                }
+                return ParityCheckMatrix(m, n, entries);
+            };
+
             // Ensure rank(H) < n by making the last row linearly dependent
-            vector<vector<int>> H_copy = H;
-            int r = computeRankGF2(H_copy);
+            ParityCheckMatrix H = toMatrix();
+            int r = computeRankGF2(H);
 
             if (r >= n && m > 0) {
                 // Make the last row the XOR of some random subset of preceding rows
-                fill(H[m-1].begin(), H[m-1].end(), 0);
+                vector<int> lastRow(n, 0);
                 
                 // Randomly select some rows to XOR
                 for (int row = 0; row < m-1; row++) {
                     if (uniform_int_distribution<>(0, 1)(gen)) {  // 50% chance
-                        for (int col = 0; col < n; col++) {
-                            H[m-1][col] ^= H[row][col];
+                        for (int col : rowCols[row]) {
+                            lastRow[col] ^= 1;
                         }
                     }
                 }
 
                 // If the resulting row has fewer than 2 ones, add ones until we have at least 2
-                int ones = count(H[m-1].begin(), H[m-1].end(), 1);
+                int ones = count(lastRow.begin(), lastRow.end(), 1);
                 if (ones < 2) {
                     vector<int> zero_positions;
                     for (int col = 0; col < n; col++) {
-                        if (H[m-1][col] == 0) {
+                        if (lastRow[col] == 0) {
                             zero_positions.push_back(col);
                         }
                     }
                     shuffle(zero_positions.begin(), zero_positions.end(), gen);
                     for (int i = 0; i < min(2 - ones, (int)zero_positions.size()); i++) {
-                        H[m-1][zero_positions[i]] = 1;
+                        lastRow[zero_positions[i]] = 1;
                     }
                 }
+
+                rowCols[m-1].clear();
+                for (int col = 0; col < n; col++) {
+                    if (lastRow[col]) rowCols[m-1].push_back(col);
+                }
+                H = toMatrix();
             }
 
             return H;  // Return successfully generated matrix
@@ -427,6 +362,10 @@ vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
     throw runtime_error("Failed to generate valid parity check matrix after maximum attempts");
 }
 
+vector<vector<int>> generateRandomParityCheckMatrix(int m, int n, int w) {
+    return generateRandomSparseParityCheckMatrix(m, n, w).toDense();
+}
+
 
 // Helper function to verify matrix constraints
 bool verifyMatrixConstraints(const vector<vector<int>>& H, int w) {
@@ -455,6 +394,18 @@ bool verifyMatrixConstraints(const vector<vector<int>>& H, int w) {
     return true;
 }
 
+// Sparse overload: weights are read straight from the CSR/CSC offsets
+bool verifyMatrixConstraints(const ParityCheckMatrix& H, int w) {
+    if (H.empty()) return false;
+    for (int i = 0; i < H.rows(); i++) {
+        if (H.rowWeight(i) > w) return false;
+    }
+    for (int j = 0; j < H.cols(); j++) {
+        if (H.colWeight(j) > w) return false;
+    }
+    return true;
+}
+
 // Example main
 // int main(){
 //     // Example usage: H is a 2x4 parity-check matrix
@@ -0,0 +1,163 @@
+#include "../include/gf2_batch.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include "../include/cpu_dispatch.hpp"
+using namespace std;
+
+/*
+ * In-place transpose of a 64 x 64 bit matrix: afterwards bit i of a[j]
+ * is the former bit j of a[i]. Six rounds of masked block swaps.
+ */
+static GF2_FORCE_INLINE void transpose64(uint64_t a[64]) {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    for(int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+        for(int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+/*
+ * Lane types for the bit-sliced kernel: 64, 256 or 512 states per block.
+ * The wide types are compiler vector extensions, so the same kernel body
+ * becomes plain 64-bit, AVX2 or AVX-512 code depending on the target of
+ * the wrapper it is inlined into.
+ */
+typedef uint64_t Lanes256 __attribute__((vector_size(32)));
+typedef uint64_t Lanes512 __attribute__((vector_size(64)));
+
+/*
+ * Bit-sliced kernel over lane type T (sizeof(T) / 8 words per slice).
+ * slices[c * words + g] holds bit c of states 64g .. 64g+63 of the block.
+ */
+template<class T>
+static GF2_FORCE_INLINE void batchKernel(const PackedMatrix& PH, const vector<vector<int>>& rowCols,
+                                         const uint64_t* states, size_t count, int* energies) {
+    constexpr int words = (int)(sizeof(T) / sizeof(uint64_t));
+    const int n = PH.cols;
+    const int W = PH.wordsPerRow;
+    const int lanes = 64 * words;
+
+    // Counter planes needed to hold energies up to ℓ
+    int counterBits = 1;
+    while((1 << counterBits) <= PH.rows) counterBits++;
+
+    vector<uint64_t> slices((size_t)max(n, 1) * words, 0);
+    T counters[32];
+    vector<uint64_t> counterWords((size_t)counterBits * words);
+    uint64_t block[64];
+
+    for(size_t start = 0; start < count; start += lanes) {
+        size_t inBlock = min((size_t)lanes, count - start);
+
+        // Transpose 64 states at a time, one word column at a time
+        for(int g = 0; g < words; g++) {
+            for(int w = 0; w < W; w++) {
+                for(int i = 0; i < 64; i++) {
+                    size_t s = (size_t)g * 64 + i;
+                    block[i] = (s < inBlock) ? states[(start + s) * W + w] : 0;
+                }
+                transpose64(block);
+                for(int b = 0; b < 64 && w * 64 + b < n; b++) {
+                    slices[(size_t)(w * 64 + b) * words + g] = block[b];
+                }
+            }
+        }
+
+        for(int k = 0; k < counterBits; k++) counters[k] = T{};
+
+        // Syndrome bit of row r for every lane, then add it to the counters
+        for(int r = 0; r < PH.rows; r++) {
+            T parity = T{};
+            for(int c : rowCols[r]) {
+                T slice;
+                memcpy(&slice, &slices[(size_t)c * words], sizeof(T));
+                parity ^= slice;
+            }
+            T carry = parity;
+            for(int k = 0; k < counterBits; k++) {
+                T t = counters[k] & carry;
+                counters[k] ^= carry;
+                carry = t;
+            }
+        }
+
+        // Gather each lane's counter bits back into an integer energy
+        for(int k = 0; k < counterBits; k++) {
+            memcpy(&counterWords[(size_t)k * words], &counters[k], sizeof(T));
+        }
+        for(size_t s = 0; s < inBlock; s++) {
+            int e = 0;
+            for(int k = 0; k < counterBits; k++) {
+                e |= (int)((counterWords[(size_t)k * words + s / 64] >> (s % 64)) & 1) << k;
+            }
+            energies[start + s] = e;
+        }
+    }
+}
+
+static void batchGeneric(const PackedMatrix& PH, const vector<vector<int>>& rowCols,
+                         const uint64_t* states, size_t count, int* energies) {
+    batchKernel<uint64_t>(PH, rowCols, states, count, energies);
+}
+#ifdef GF2_HAVE_X86_KERNELS
+GF2_TARGET_AVX2 static void batchAvx2(const PackedMatrix& PH, const vector<vector<int>>& rowCols,
+                                      const uint64_t* states, size_t count, int* energies) {
+    batchKernel<Lanes256>(PH, rowCols, states, count, energies);
+}
+GF2_TARGET_AVX512 static void batchAvx512(const PackedMatrix& PH, const vector<vector<int>>& rowCols,
+                                          const uint64_t* states, size_t count, int* energies) {
+    batchKernel<Lanes512>(PH, rowCols, states, count, energies);
+}
+#endif
+
+int energyBatchLanes() {
+    switch(activeGf2Isa()) {
+#ifdef GF2_HAVE_X86_KERNELS
+        case Gf2Isa::Avx512: return 512;
+        case Gf2Isa::Avx2: return 256;
+#endif
+        default: return 64;
+    }
+}
+
+void energyOfStatesBatch(const PackedMatrix& PH, const uint64_t* states,
+                         size_t count, int* energies) {
+    if(count == 0) return;
+    if(PH.rows == 0) {
+        fill(energies, energies + count, 0);
+        return;
+    }
+
+    // Column support of every row, so a row costs (row weight) XORs
+    vector<vector<int>> rowCols(PH.rows);
+    for(int r = 0; r < PH.rows; r++) {
+        for(int c = 0; c < PH.cols; c++) {
+            if(PH.get(r, c)) rowCols[r].push_back(c);
+        }
+    }
+
+    switch(activeGf2Isa()) {
+#ifdef GF2_HAVE_X86_KERNELS
+        case Gf2Isa::Avx512: batchAvx512(PH, rowCols, states, count, energies); return;
+        case Gf2Isa::Avx2: batchAvx2(PH, rowCols, states, count, energies); return;
+#endif
+        default: batchGeneric(PH, rowCols, states, count, energies); return;
+    }
+}
+
+vector<int> energyOfStatesBatch(const PackedMatrix& PH, const vector<PackedState>& states) {
+    const int W = PH.wordsPerRow;
+    vector<uint64_t> flat((size_t)states.size() * W, 0);
+    for(size_t s = 0; s < states.size(); s++) {
+        copy_n(states[s].begin(), min((int)states[s].size(), W), flat.begin() + s * W);
+    }
+    vector<int> energies(states.size());
+    energyOfStatesBatch(PH, flat.data(), states.size(), energies.data());
+    return energies;
+}
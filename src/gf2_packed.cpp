@@ -0,0 +1,232 @@
+#include "../include/gf2_packed.hpp"
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include "../include/cpu_dispatch.hpp"
+#ifdef GF2_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+using namespace std;
+
+/*
+ * Pack a dense ℓ x n 0/1 matrix into 64-bit words, row by row.
+ */
+PackedMatrix packMatrix(const vector<vector<int>>& H) {
+    PackedMatrix PH;
+    PH.rows = (int)H.size();
+    PH.cols = PH.rows ? (int)H[0].size() : 0;
+    PH.wordsPerRow = wordsForBits(PH.cols);
+    PH.data.assign((size_t)PH.rows * PH.wordsPerRow, 0);
+
+    for(int r = 0; r < PH.rows; r++) {
+        for(int c = 0; c < PH.cols; c++) {
+            if(H[r][c] & 1) PH.set(r, c);
+        }
+    }
+    return PH;
+}
+
+// Expand a packed matrix back to the dense vector<vector<int>> form
+vector<vector<int>> unpackMatrix(const PackedMatrix& PH) {
+    vector<vector<int>> H(PH.rows, vector<int>(PH.cols, 0));
+    for(int r = 0; r < PH.rows; r++) {
+        for(int c = 0; c < PH.cols; c++) {
+            H[r][c] = PH.get(r, c);
+        }
+    }
+    return H;
+}
+
+// Pack a dense 0/1 vector into 64-bit words
+PackedState packState(const vector<int>& x) {
+    int n = (int)x.size();
+    PackedState px(wordsForBits(n), 0);
+    for(int c = 0; c < n; c++) {
+        if(x[c] & 1) flipBit(px.data(), c);
+    }
+    return px;
+}
+
+// Expand the first n bits of a packed state to a dense 0/1 vector
+vector<int> unpackState(const PackedState& px, int n) {
+    vector<int> x(n, 0);
+    for(int c = 0; c < n; c++) {
+        x[c] = getBit(px.data(), c);
+    }
+    return x;
+}
+
+/*
+ * E(x) over packed words. For each row, fold row & x over all words with
+ * XOR (parity is linear), then a single popcount gives the syndrome bit.
+ * If syndrome is non-null the violated rows are also recorded there.
+ */
+static GF2_FORCE_INLINE int energyBody(const PackedMatrix& PH, const uint64_t* x, uint64_t* syndrome) {
+    const int W = PH.wordsPerRow;
+    const uint64_t* rowPtr = PH.data.data();
+    int countViolated = 0;
+
+    for(int r = 0; r < PH.rows; r++, rowPtr += W) {
+        uint64_t acc = 0;
+        for(int w = 0; w < W; w++) {
+            acc ^= rowPtr[w] & x[w];
+        }
+        int bit = __builtin_popcountll(acc) & 1;
+        countViolated += bit;
+        if(syndrome && bit) flipBit(syndrome, r);
+    }
+    return countViolated;
+}
+
+static int energyGeneric(const PackedMatrix& PH, const uint64_t* x, uint64_t* s) { return energyBody(PH, x, s); }
+#ifdef GF2_HAVE_X86_KERNELS
+GF2_TARGET_POPCNT static int energyPopcnt(const PackedMatrix& PH, const uint64_t* x, uint64_t* s) { return energyBody(PH, x, s); }
+#endif
+
+/*
+ * Energy (and optionally syndrome) with the kernel of the active level.
+ * Rows are only a few words long, so vectorizing the word loop does not
+ * pay off; every x86 level above Generic uses the POPCNT build.
+ */
+static int energyDispatch(const PackedMatrix& PH, const uint64_t* x, uint64_t* syndrome) {
+    switch(activeGf2Isa()) {
+#ifdef GF2_HAVE_X86_KERNELS
+        case Gf2Isa::Avx512:
+        case Gf2Isa::Avx2:
+        case Gf2Isa::Popcnt: return energyPopcnt(PH, x, syndrome);
+#endif
+        default: return energyGeneric(PH, x, syndrome);
+    }
+}
+
+int energyOfStatePacked(const PackedMatrix& PH, const uint64_t* x) {
+    return energyDispatch(PH, x, nullptr);
+}
+
+int energyOfStatePacked(const PackedMatrix& PH, const PackedState& x) {
+    return energyDispatch(PH, x.data(), nullptr);
+}
+
+// Syndrome bit r is the parity of row r & x
+PackedState syndromeOfStatePacked(const PackedMatrix& PH, const uint64_t* x) {
+    PackedState syndrome(wordsForBits(PH.rows), 0);
+    energyDispatch(PH, x, syndrome.data());
+    return syndrome;
+}
+
+// Transpose the row-major packed matrix into per-column check lists
+vector<vector<int>> columnChecks(const PackedMatrix& PH) {
+    vector<vector<int>> checks(PH.cols);
+    for(int r = 0; r < PH.rows; r++) {
+        for(int c = 0; c < PH.cols; c++) {
+            if(PH.get(r, c)) checks[c].push_back(r);
+        }
+    }
+    return checks;
+}
+
+/*
+ * In-place Gauss-Jordan elimination of PH; returns the pivot columns.
+ * The row XORs are plain word loops, which the AVX2/AVX-512 wrappers
+ * below turn into vector instructions for wide rows.
+ */
+static GF2_FORCE_INLINE vector<int> eliminationBody(PackedMatrix& PH) {
+    const int rows = PH.rows;
+    const int cols = PH.cols;
+    const int W = PH.wordsPerRow;
+
+    int pivotRow = 0;
+    vector<int> pivotCols;
+
+    for(int col = 0; col < cols && pivotRow < rows; col++) {
+        int pivotCandidate = -1;
+        for(int r = pivotRow; r < rows; r++) {
+            if(PH.get(r, col)) {
+                pivotCandidate = r;
+                break;
+            }
+        }
+        if(pivotCandidate == -1) continue;
+
+        if(pivotCandidate != pivotRow) {
+            swap_ranges(PH.row(pivotRow), PH.row(pivotRow) + W, PH.row(pivotCandidate));
+        }
+        pivotCols.push_back(col);
+
+        // Clear this column in every other row; words left of col/64 are
+        // already zero in the pivot row, so start at the pivot word.
+        const uint64_t* pivot = PH.row(pivotRow);
+        for(int r = 0; r < rows; r++) {
+            if(r != pivotRow && PH.get(r, col)) {
+                uint64_t* target = PH.row(r);
+                for(int w = col >> 6; w < W; w++) {
+                    target[w] ^= pivot[w];
+                }
+            }
+        }
+        pivotRow++;
+    }
+    return pivotCols;
+}
+
+static vector<int> eliminateGeneric(PackedMatrix& PH) { return eliminationBody(PH); }
+#ifdef GF2_HAVE_X86_KERNELS
+GF2_TARGET_AVX2 static vector<int> eliminateAvx2(PackedMatrix& PH) { return eliminationBody(PH); }
+GF2_TARGET_AVX512 static vector<int> eliminateAvx512(PackedMatrix& PH) { return eliminationBody(PH); }
+#endif
+
+/*
+ * Packed Gaussian elimination over GF(2), producing the same RREF,
+ * pivot columns and rank as the dense gaussianEliminationGF2.
+ */
+tuple<PackedMatrix, vector<int>, int>
+gaussianEliminationGF2Packed(const PackedMatrix& PH_in) {
+    PackedMatrix PH(PH_in);
+    vector<int> pivotCols;
+    switch(activeGf2Isa()) {
+#ifdef GF2_HAVE_X86_KERNELS
+        case Gf2Isa::Avx512: pivotCols = eliminateAvx512(PH); break;
+        case Gf2Isa::Avx2: pivotCols = eliminateAvx2(PH); break;
+#endif
+        default: pivotCols = eliminateGeneric(PH); break;
+    }
+    int rank = (int)pivotCols.size();
+    return make_tuple(PH, pivotCols, rank);
+}
+
+/*
+ * Write the first n bits of x as '0'/'1' characters. With BMI2, PDEP
+ * spreads 8 bits into the low bit of 8 bytes at once.
+ */
+static GF2_FORCE_INLINE void bitStringBody(const uint64_t* x, int n, char* out) {
+    for(int c = 0; c < n; c++) {
+        out[c] = getBit(x, c) ? '1' : '0';
+    }
+}
+
+static void bitStringGeneric(const uint64_t* x, int n, char* out) { bitStringBody(x, n, out); }
+#ifdef GF2_HAVE_X86_KERNELS
+GF2_TARGET_AVX2 static void bitStringBmi2(const uint64_t* x, int n, char* out) {
+    int c = 0;
+    for(; c + 8 <= n; c += 8) {
+        uint64_t byte = (x[c >> 6] >> (c & 63)) & 0xFF;
+        uint64_t chars = _pdep_u64(byte, 0x0101010101010101ULL) | 0x3030303030303030ULL;
+        memcpy(out + c, &chars, 8);
+    }
+    for(; c < n; c++) {
+        out[c] = getBit(x, c) ? '1' : '0';
+    }
+}
+#endif
+
+void packedToBitString(const uint64_t* x, int n, char* out) {
+    switch(activeGf2Isa()) {
+#ifdef GF2_HAVE_X86_KERNELS
+        case Gf2Isa::Avx512:
+        case Gf2Isa::Avx2: bitStringBmi2(x, n, out); return;
+#endif
+        default: bitStringGeneric(x, n, out); return;
+    }
+}
@@ -0,0 +1,82 @@
+#include "../include/parity_check_matrix.hpp"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+/*
+ * Build the CSR arrays from (row, column) entries, cancelling repeated
+ * entries in pairs, then derive the CSC arrays by a counting transpose.
+ */
+ParityCheckMatrix::ParityCheckMatrix(int rows, int cols, const vector<pair<int,int>>& entries)
+    : numRows(rows), numCols(cols) {
+    if(rows < 0 || cols < 0) throw invalid_argument("matrix dimensions must be non-negative");
+
+    vector<pair<int,int>> sorted(entries);
+    for(const auto& e : sorted) {
+        if(e.first < 0 || e.first >= rows || e.second < 0 || e.second >= cols) {
+            throw out_of_range("parity-check entry outside the matrix");
+        }
+    }
+    sort(sorted.begin(), sorted.end());
+
+    rowPtr.assign(rows + 1, 0);
+    colIdx.clear();
+    colIdx.reserve(sorted.size());
+    for(size_t i = 0; i < sorted.size(); ) {
+        size_t j = i;
+        while(j < sorted.size() && sorted[j] == sorted[i]) j++;
+        // An entry repeated an even number of times is zero over GF(2)
+        if((j - i) & 1) {
+            colIdx.push_back(sorted[i].second);
+            rowPtr[sorted[i].first + 1]++;
+        }
+        i = j;
+    }
+    for(int r = 0; r < rows; r++) rowPtr[r + 1] += rowPtr[r];
+
+    // Counting transpose: rows are visited in order, so each column's
+    // check list comes out sorted
+    colPtr.assign(cols + 1, 0);
+    for(int c : colIdx) colPtr[c + 1]++;
+    for(int c = 0; c < cols; c++) colPtr[c + 1] += colPtr[c];
+    rowIdx.assign(colIdx.size(), 0);
+    vector<int> next(colPtr.begin(), colPtr.end() - 1);
+    for(int r = 0; r < rows; r++) {
+        for(int c : row(r)) rowIdx[next[c]++] = r;
+    }
+}
+
+// Collect the positions of the ones of a dense matrix
+static vector<pair<int,int>> denseEntries(const vector<vector<int>>& H) {
+    vector<pair<int,int>> entries;
+    for(int r = 0; r < (int)H.size(); r++) {
+        for(int c = 0; c < (int)H[r].size(); c++) {
+            if(H[r][c] & 1) entries.push_back({r, c});
+        }
+    }
+    return entries;
+}
+
+ParityCheckMatrix::ParityCheckMatrix(const vector<vector<int>>& H)
+    : ParityCheckMatrix((int)H.size(), H.empty() ? 0 : (int)H[0].size(), denseEntries(H)) {}
+
+vector<vector<int>> ParityCheckMatrix::toDense() const {
+    vector<vector<int>> H(numRows, vector<int>(numCols, 0));
+    for(int r = 0; r < numRows; r++) {
+        for(int c : row(r)) H[r][c] = 1;
+    }
+    return H;
+}
+
+PackedMatrix ParityCheckMatrix::toPacked() const {
+    PackedMatrix PH;
+    PH.rows = numRows;
+    PH.cols = numCols;
+    PH.wordsPerRow = wordsForBits(numCols);
+    PH.data.assign((size_t)numRows * PH.wordsPerRow, 0);
+    for(int r = 0; r < numRows; r++) {
+        for(int c : row(r)) PH.set(r, c);
+    }
+    return PH;
+}
@@ -0,0 +1,192 @@
+#include "../include/quasi_cyclic.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/packed_search.hpp"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <iostream>
+using namespace std;
+
+// nbits (<= 64) bits of x starting at bit pos, as the low bits of a word
+static inline uint64_t readBits(const uint64_t* x, int pos, int nbits) {
+    int w = pos >> 6, off = pos & 63;
+    uint64_t v = x[w] >> off;
+    if(off && off + nbits > 64) v |= x[w + 1] << (64 - off);
+    return nbits == 64 ? v : v & ((uint64_t(1) << nbits) - 1);
+}
+
+// dst[dstStart .. dstStart+len) ^= src[srcStart .. srcStart+len)
+static void xorBits(const uint64_t* src, int srcStart, uint64_t* dst, int dstStart, int len) {
+    for(int k = 0; k < len; k += 64) {
+        int chunk = min(64, len - k);
+        uint64_t v = readBits(src, srcStart + k, chunk);
+        int pos = dstStart + k;
+        int w = pos >> 6, off = pos & 63;
+        dst[w] ^= v << off;
+        if(off && off + chunk > 64) dst[w + 1] ^= v >> (64 - off);
+    }
+}
+
+QuasiCyclicCode::QuasiCyclicCode(int circulantSize, const vector<vector<vector<int>>>& exponents)
+    : L(circulantSize), numBlockRows((int)exponents.size()),
+      numBlockCols(exponents.empty() ? 0 : (int)exponents[0].size()) {
+    if(L <= 0) throw invalid_argument("QuasiCyclicCode: circulant size must be positive");
+    blocks.resize((size_t)numBlockRows * numBlockCols);
+    for(int i = 0; i < numBlockRows; i++) {
+        if((int)exponents[i].size() != numBlockCols) {
+            throw invalid_argument("QuasiCyclicCode: block rows have different lengths");
+        }
+        for(int j = 0; j < numBlockCols; j++) {
+            vector<int> terms;
+            for(int e : exponents[i][j]) terms.push_back(((e % L) + L) % L);
+            sort(terms.begin(), terms.end());
+
+            // Equal exponents cancel in pairs over GF(2)
+            vector<int>& block = blocks[i * numBlockCols + j];
+            for(size_t k = 0; k < terms.size(); ) {
+                size_t run = k;
+                while(run < terms.size() && terms[run] == terms[k]) run++;
+                if((run - k) % 2) block.push_back(terms[k]);
+                k = run;
+            }
+        }
+    }
+}
+
+QuasiCyclicCode QuasiCyclicCode::fromParityCheckMatrix(const ParityCheckMatrix& H, int circulantSize) {
+    int L = circulantSize;
+    if(L <= 0 || H.rows() % L || H.cols() % L) {
+        throw invalid_argument("fromParityCheckMatrix: H dimensions are not multiples of the circulant size");
+    }
+    int bRows = H.rows() / L, bCols = H.cols() / L;
+
+    // Exponents of every block, read from the first row of the block
+    vector<vector<vector<int>>> exponents(bRows, vector<vector<int>>(bCols));
+    for(int i = 0; i < bRows; i++) {
+        for(int c : H.row(i * L)) exponents[i][c / L].push_back(c % L);
+    }
+    QuasiCyclicCode code(L, exponents);
+
+    // Every other row must be the matching rotation
+    for(int r = 0; r < H.rows(); r++) {
+        vector<int> expected;
+        for(int j = 0; j < bCols; j++) {
+            for(int e : code.exponents(r / L, j)) expected.push_back(j * L + (r % L + e) % L);
+        }
+        sort(expected.begin(), expected.end());
+        if(!equal(expected.begin(), expected.end(), H.row(r).begin(), H.row(r).end())) {
+            throw invalid_argument("fromParityCheckMatrix: H is not quasi-cyclic with this circulant size");
+        }
+    }
+    return code;
+}
+
+int QuasiCyclicCode::entry(int r, int c) const {
+    int shift = ((c % L) - (r % L) + L) % L;
+    const vector<int>& block = exponents(r / L, c / L);
+    return binary_search(block.begin(), block.end(), shift) ? 1 : 0;
+}
+
+ParityCheckMatrix QuasiCyclicCode::toParityCheckMatrix() const {
+    vector<pair<int,int>> entries;
+    for(int i = 0; i < numBlockRows; i++) {
+        for(int j = 0; j < numBlockCols; j++) {
+            for(int e : exponents(i, j)) {
+                for(int r = 0; r < L; r++) entries.push_back({i * L + r, j * L + (r + e) % L});
+            }
+        }
+    }
+    return ParityCheckMatrix(rows(), cols(), entries);
+}
+
+vector<vector<int>> QuasiCyclicCode::toDense() const {
+    return toParityCheckMatrix().toDense();
+}
+
+int QuasiCyclicCode::energy(const uint64_t* x) const {
+    vector<uint64_t> s(wordsForBits(L));
+    int energy = 0;
+    for(int i = 0; i < numBlockRows; i++) {
+        fill(s.begin(), s.end(), 0);
+        for(int j = 0; j < numBlockCols; j++) {
+            // s[r] ^= x[j*L + (r + e) mod L], split at the wrap-around
+            for(int e : exponents(i, j)) {
+                xorBits(x, j * L + e, s.data(), 0, L - e);
+                xorBits(x, j * L, s.data(), L - e, e);
+            }
+        }
+        for(uint64_t w : s) energy += __builtin_popcountll(w);
+    }
+    return energy;
+}
+
+int QuasiCyclicCode::energy(const vector<int>& x) const {
+    if((int)x.size() != cols()) throw invalid_argument("QuasiCyclicCode::energy: state length does not match H");
+    PackedState px = packState(x);
+    return energy(px.data());
+}
+
+vector<int> QuasiCyclicCode::shiftPermutation(int t) const {
+    t = ((t % L) + L) % L;
+    vector<int> perm(cols());
+    for(int j = 0; j < numBlockCols; j++) {
+        for(int c = 0; c < L; c++) perm[j * L + c] = j * L + (c + t) % L;
+    }
+    return perm;
+}
+
+vector<int> QuasiCyclicCode::shiftState(const vector<int>& x, int t) const {
+    vector<int> perm = shiftPermutation(t);
+    vector<int> y(x.size());
+    for(size_t c = 0; c < x.size(); c++) y[perm[c]] = x[c];
+    return y;
+}
+
+void QuasiCyclicCode::shiftState(const uint64_t* x, int t, uint64_t* y) const {
+    fill(y, y + wordsForBits(cols()), uint64_t(0));
+    for(int j = 0; j < numBlockCols; j++) {
+        // Bits [0, L - t) of the block move up by t, the rest wrap to 0
+        xorBits(x, j * L, y, j * L + t, L - t);
+        xorBits(x, j * L + L - t, y, j * L, t);
+    }
+}
+
+vector<int> QuasiCyclicCode::invariantShifts(const vector<int>& x) const {
+    vector<int> shifts;
+    for(int t = 0; t < L; t++) {
+        if(shiftState(x, t) == x) shifts.push_back(t);
+    }
+    return shifts;
+}
+
+int computeEnergyBarrierQuasiCyclic(const QuasiCyclicCode& code, const vector<int>& c_target) {
+    if((int)c_target.size() != code.cols()) {
+        throw invalid_argument("computeEnergyBarrierQuasiCyclic: target length does not match H");
+    }
+    bool isAllZero = none_of(c_target.begin(), c_target.end(), [](int bit) { return bit & 1; });
+    if(isAllZero) return 0;
+
+    vector<int> shifts;
+    for(int t : code.invariantShifts(c_target)) if(t) shifts.push_back(t);
+
+    // Replace a state by the smallest of its shifts, as an n-bit integer.
+    // Shifts preserve energy and fix 0 and c_target, so the barrier is
+    // unchanged.
+    size_t sw = wordsForBits(code.cols());
+    vector<uint64_t> image(sw), best(sw);
+    auto canonicalize = [&](uint64_t* x) {
+        copy(x, x + sw, best.begin());
+        for(int t : shifts) {
+            code.shiftState(x, t, image.data());
+            if(lexicographical_compare(image.rbegin(), image.rend(), best.rbegin(), best.rend())) best = image;
+        }
+        if(equal(best.begin(), best.end(), x)) return false;
+        copy(best.begin(), best.end(), x);
+        return true;
+    };
+
+    int barrier = packedBarrierSearch(code, packState(c_target), INT_MAX, canonicalize);
+    if(barrier < 0) cerr << "ERROR: c_target not reachable. Is it a valid codeword?" << endl;
+    return barrier;
+}
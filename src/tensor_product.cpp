@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include "../include/parity_check_matrix.hpp"
 using namespace std;
 
 /*
@@ -66,6 +67,43 @@ vector<vector<int>> buildTensorProductParityCheck(
 }
 
 
+/*
+ * Sparse overload: every one of H1 contributes an n2-entry diagonal and
+ * every copy of H2 contributes nnz(H2) entries, so the result is built in
+ * O(nnz(H3)) without allocating the (m1*n2 + n1*m2) x (n1*n2) dense grid.
+ */
+ParityCheckMatrix buildTensorProductParityCheck(
+    const ParityCheckMatrix& H1, // m1 x n1
+    const ParityCheckMatrix& H2  // m2 x n2
+) {
+    int m1 = H1.rows(), n1 = H1.cols();
+    int m2 = H2.rows(), n2 = H2.cols();
+
+    vector<pair<int,int>> entries;
+    entries.reserve(H1.nnz() * n2 + n1 * H2.nnz());
+
+    // Top Block: H1 ⊗ I_{n2}
+    for(int i = 0; i < m1; i++){
+        for(int j : H1.row(i)){
+            for(int k = 0; k < n2; k++){
+                entries.push_back({i*n2 + k, j*n2 + k});
+            }
+        }
+    }
+
+    // Bottom Block: I_{n1} ⊗ H2
+    int bottomBlockStart = m1*n2;
+    for(int i = 0; i < n1; i++){
+        for(int r = 0; r < m2; r++){
+            for(int c : H2.row(r)){
+                entries.push_back({bottomBlockStart + i*m2 + r, i*n2 + c});
+            }
+        }
+    }
+
+    return ParityCheckMatrix(m1*n2 + n1*m2, n1*n2, entries);
+}
+
 /*
  * Build the tensor product codeword from two codewords c1 and c2.
  * The result is a codeword of length n1 * n2.
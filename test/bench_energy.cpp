@@ -0,0 +1,118 @@
+#include "../include/energy_barrier.hpp"
+#include "../include/generate_codeword.hpp"
+#include "../include/tensor_product.hpp"
+#include "../include/gf2_packed.hpp"
+#include "../include/gf2_batch.hpp"
+#include "../include/cpu_dispatch.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+
+using namespace std;
+
+// Throughput in states per second for 'count' states evaluated in 'seconds'
+static double statesPerSec(size_t count, double seconds) {
+    return seconds > 0 ? count / seconds : 0.0;
+}
+
+// Time the scalar, packed and batch energy kernels on random states of H
+static bool benchmarkMatrix(const vector<vector<int>>& H, const string& name, size_t count) {
+    int n = H.empty() ? 0 : (int)H[0].size();
+    PackedMatrix PH = packMatrix(H);
+    const int W = PH.wordsPerRow;
+
+    mt19937_64 gen(12345);
+    vector<vector<int>> dense(count, vector<int>(n));
+    vector<uint64_t> flat(count * W, 0);
+    for(size_t s = 0; s < count; s++) {
+        for(int c = 0; c < n; c++) {
+            dense[s][c] = (int)(gen() & 1);
+            if(dense[s][c]) flipBit(&flat[s * W], c);
+        }
+    }
+
+    vector<int> eDense(count), ePacked(count), eBatch(count);
+    auto secs = [](auto a, auto b) { return chrono::duration<double>(b - a).count(); };
+
+    auto t0 = chrono::steady_clock::now();
+    for(size_t s = 0; s < count; s++) eDense[s] = energyOfState(H, dense[s]);
+    auto t1 = chrono::steady_clock::now();
+    double dDense = statesPerSec(count, secs(t0, t1));
+
+    cout << name << " (" << H.size() << " x " << n << "), " << count << " states" << endl;
+    cout << fixed << setprecision(3);
+    cout << "  energyOfState                : " << setw(10) << dDense / 1e6 << " Mstates/s" << endl;
+
+    // Packed and batch kernels at every level this CPU supports
+    bool ok = true;
+    Gf2Isa saved = activeGf2Isa();
+    for(Gf2Isa isa : {Gf2Isa::Generic, Gf2Isa::Popcnt, Gf2Isa::Avx2, Gf2Isa::Avx512}) {
+        if(!gf2IsaSupported(isa)) continue;
+        forceGf2Isa(isa);
+        string tag = "[" + gf2IsaName(isa) + "]";
+
+        auto t2 = chrono::steady_clock::now();
+        for(size_t s = 0; s < count; s++) ePacked[s] = energyOfStatePacked(PH, &flat[s * W]);
+        auto t3 = chrono::steady_clock::now();
+        energyOfStatesBatch(PH, flat.data(), count, eBatch.data());
+        auto t4 = chrono::steady_clock::now();
+
+        double dPacked = statesPerSec(count, secs(t2, t3));
+        double dBatch = statesPerSec(count, secs(t3, t4));
+        cout << "  energyOfStatePacked " << setw(9) << left << tag << right << ": " << setw(10) << dPacked / 1e6 << " Mstates/s"
+             << "  (x" << setprecision(1) << dPacked / dDense << ")" << setprecision(3) << endl;
+        cout << "  energyOfStatesBatch " << setw(9) << left << tag << right << ": " << setw(10) << dBatch / 1e6 << " Mstates/s"
+             << "  (x" << setprecision(1) << dBatch / dDense << ")" << setprecision(3) << endl;
+        ok &= (eDense == ePacked) && (eDense == eBatch);
+    }
+    forceGf2Isa(saved);
+
+    cout << "  results " << (ok ? "match" : "MISMATCH") << endl << endl;
+    return ok;
+}
+
+int main() {
+    cout << "GF(2) kernels: " << gf2IsaName(activeGf2Isa())
+         << " (detected " << gf2IsaName(detectGf2Isa()) << ", batch width "
+         << energyBatchLanes() << " states)" << endl << endl;
+
+    // The 3 x 3 ring code and the 18 x 9 code from test/ebc_tp.cpp
+    vector<vector<int>> H1 = {
+        {1,1,0},
+        {0,1,1},
+        {1,0,1}
+    };
+    vector<vector<int>> H2 = {
+        {1,0,0,1,0,0,0,0,0},
+        {0,1,0,0,1,0,0,0,0},
+        {0,0,1,0,0,1,0,0,0},
+        {0,0,0,1,0,0,1,0,0},
+        {0,0,0,0,1,0,0,1,0},
+        {0,0,0,0,0,1,0,0,1},
+        {1,0,0,0,0,0,1,0,0},
+        {0,1,0,0,0,0,0,1,0},
+        {0,0,1,0,0,0,0,0,1},
+        {1,1,0,0,0,0,0,0,0},
+        {0,1,1,0,0,0,0,0,0},
+        {1,0,1,0,0,0,0,0,0},
+        {0,0,0,1,1,0,0,0,0},
+        {0,0,0,0,1,1,0,0,0},
+        {0,0,0,1,0,1,0,0,0},
+        {0,0,0,0,0,0,1,1,0},
+        {0,0,0,0,0,0,0,1,1},
+        {0,0,0,0,0,0,1,0,1}
+    };
+
+    bool ok = true;
+    ok &= benchmarkMatrix(H2, "H2", 1 << 18);
+    ok &= benchmarkMatrix(buildTensorProductParityCheck(H1, H2), "H1 x H2", 1 << 18);
+
+    // A random w = 3 tensor code of the size used in ebc_tp_multi_simu
+    vector<vector<int>> R1 = generateRandomParityCheckMatrix(7, 9, 3);
+    vector<vector<int>> R2 = generateRandomParityCheckMatrix(7, 9, 3);
+    ok &= benchmarkMatrix(buildTensorProductParityCheck(R1, R2), "random 7x9 x 7x9", 1 << 17);
+
+    return ok ? 0 : 1;
+}
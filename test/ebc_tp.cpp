@@ -65,20 +65,11 @@ int main() {
     int d1 = computeMinimumDistance(H1);
     cout << "Minimum distance of H1: " << d1 << endl;
     
-    // Compute energy barrier of H1
-    vector<string> codewords1 = computeAllCodewordsGF2(H1);
-    int minBarrier1 = INT_MAX;
-    string minBarrierCodeword1;
-    
-    for(const auto& cw : codewords1) {
-        if(cw.find('1') == string::npos) continue; // Skip zero codeword
-        vector<int> codewordVec = stringToVector(cw);
-        int barrier = computeEnergyBarrier(H1, codewordVec);
-        if(barrier >= 0 && barrier < minBarrier1) {
-            minBarrier1 = barrier;
-            minBarrierCodeword1 = cw;
-        }
-    }
+    // Compute energy barrier of H1: one search that stops at the
+    // first reachable nonzero codeword
+    vector<int> minCodeword1;
+    int minBarrier1 = computeCodeEnergyBarrier(H1, minCodeword1);
+    string minBarrierCodeword1 = vectorToString(minCodeword1);
     cout << "Energy barrier of H1: " << minBarrier1 << endl;
     cout << "Achieved by codeword: " << minBarrierCodeword1 << "\n\n";
 
@@ -87,20 +78,11 @@ int main() {
     int d2 = computeMinimumDistance(H2);
     cout << "Minimum distance of H2: " << d2 << endl;
     
-    // Compute energy barrier of H2
-    vector<string> codewords2 = computeAllCodewordsGF2(H2);
-    int minBarrier2 = INT_MAX;
-    string minBarrierCodeword2;
-    
-    for(const auto& cw : codewords2) {
-        if(cw.find('1') == string::npos) continue; // Skip zero codeword
-        vector<int> codewordVec = stringToVector(cw);
-        int barrier = computeEnergyBarrier(H2, codewordVec);
-        if(barrier >= 0 && barrier < minBarrier2) {
-            minBarrier2 = barrier;
-            minBarrierCodeword2 = cw;
-        }
-    }
+    // Compute energy barrier of H2: one search that stops at the
+    // first reachable nonzero codeword
+    vector<int> minCodeword2;
+    int minBarrier2 = computeCodeEnergyBarrier(H2, minCodeword2);
+    string minBarrierCodeword2 = vectorToString(minCodeword2);
     cout << "Energy barrier of H2: " << minBarrier2 << endl;
     cout << "Achieved by codeword: " << minBarrierCodeword2 << "\n\n";
 
@@ -111,47 +93,11 @@ int main() {
     int d3 = computeMinimumDistance(H3);
     cout << "Minimum distance of H3: " << d3 << endl;
     
-    // Compute energy barrier of H3
-    vector<string> codewords3 = computeAllCodewordsGF2(H3);
-    int minBarrier3 = INT_MAX;
-    string minBarrierCodeword3;
-    
-    // First, get the total number of codewords to process
-    int total_codewords = 0;
-    for(const auto& cw : codewords3) {
-        if(cw.find('1') != string::npos) { // Count non-zero codewords
-            total_codewords++;
-        }
-    }
-
-    // Initialize counter for processed codewords
-    int processed = 0;
-
-    // Process codewords with progress bar
-    for(const auto& cw : codewords3) {
-        if(cw.find('1') == string::npos) continue; // Skip zero codeword
-        
-        // Update and display progress
-        processed++;
-        float percentage = (100.0 * processed) / total_codewords;
-        cout << "\rProgress: [";
-        int pos = 50 * processed / total_codewords;
-        for (int i = 0; i < 50; ++i) {
-            if (i < pos) cout << "=";
-            else if (i == pos) cout << ">";
-            else cout << " ";
-        }
-        cout << "] " << int(percentage) << "%" << flush;
-
-        // Original processing code
-        vector<int> codewordVec = stringToVector(cw);
-        int barrier = computeEnergyBarrier(H3, codewordVec);
-        if(barrier >= 0 && barrier < minBarrier3) {
-            minBarrier3 = barrier;
-            minBarrierCodeword3 = cw;
-        }
-    }
-    cout << endl; // New line after progress bar is complete
+    // Compute energy barrier of H3: one search that stops at the
+    // first reachable nonzero codeword
+    vector<int> minCodeword3;
+    int minBarrier3 = computeCodeEnergyBarrier(H3, minCodeword3);
+    string minBarrierCodeword3 = vectorToString(minCodeword3);
     cout << "Energy barrier of H3: " << minBarrier3 << endl;
     cout << "Achieved by codeword: " << minBarrierCodeword3 << "\n\n";
 
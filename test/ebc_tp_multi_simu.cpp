@@ -7,7 +7,9 @@
 #include <random>
 #include <chrono>
 #include <iomanip>
-#include "/opt/homebrew/opt/libomp/include/omp.h"
+#include "../include/code_components.hpp"
+#include "../include/cpu_dispatch.hpp"
+#include <omp.h>
 
 
 using namespace std;
@@ -34,7 +36,9 @@ bool runSingleSimulation(int m1, int n1, int m2, int n2, int w,
                         int& d1, int& E1, int& d2, int& E2, int& E3,
                         vector<int>& codewords1,
                         vector<int>& codewords2,
-                        vector<int>& codewords3) {
+                        vector<int>& codewords3,
+                        const SearchLimits& limits,
+                        SearchStatus& e3Status) {
     try {
         cout << "\nDebug: Starting new simulation with dimensions: " 
              << "m1=" << m1 << ", n1=" << n1 
@@ -101,8 +105,9 @@ bool runSingleSimulation(int m1, int n1, int m2, int n2, int w,
         // Compute energy barriers
         try {
             cout << "Debug: Computing energy barriers..." << endl;
-            E1 = computeEnergyBarrier(H1, codewords1);
-            E2 = computeEnergyBarrier(H2, codewords2);
+            // Sparse random H often splits into independent components
+            E1 = computeEnergyBarrierDecomposed(H1, codewords1);
+            E2 = computeEnergyBarrierDecomposed(H2, codewords2);
             
             if (E1 < 0 || E2 < 0) {
                 cout << "Invalid energy barriers found" << endl;
@@ -131,7 +136,39 @@ bool runSingleSimulation(int m1, int n1, int m2, int n2, int w,
         // Compute tensor product energy barrier
         try {
             cout << "Debug: Computing tensor product energy barrier..." << endl;
-            E3 = computeEnergyBarrier(H3, codewords3);
+            ParityCheckMatrix P3(H3);
+            const vector<int>& c3 = codewords3;
+
+            // Only E3 < min(d1*E2, E1*d2) - 2 matters, so screen with the
+            // threshold query and compute E3 exactly only for a
+            // counterexample; otherwise E3 is reported as the threshold,
+            // a lower bound that already fails the test.
+            //
+            // Both searches stop cooperatively at the trial deadline; a
+            // barrier already shown to be below the threshold still
+            // counts, with E3 reported as the best upper bound known and
+            // e3Status saying the exact search did not finish.
+            int threshold = min(d1 * E2, E1 * d2) - 2;
+            BarrierResult screen = energyBarrierBelowLimited(P3, c3, threshold, limits);
+            if (!screen.complete()) {
+                cout << "Debug: tensor product search stopped (" << searchStatusName(screen.status)
+                     << ") after " << screen.statesExplored << " states" << endl;
+                return false;
+            }
+            if (screen.upperBound >= 0 && screen.upperBound < threshold) {
+                // The threshold is a proven incumbent: only states below
+                // it can lie on a path that attains E3
+                BarrierResult exact = computeEnergyBarrierLimited(P3, c3, limits, threshold);
+                e3Status = exact.status;
+                if (exact.complete()) {
+                    E3 = exact.barrier;
+                } else {
+                    E3 = exact.upperBound >= 0 ? min(screen.upperBound, exact.upperBound)
+                                               : screen.upperBound;
+                }
+            } else {
+                E3 = threshold;
+            }
         } catch (const exception& e) {
             cout << "Error in computing tensor product energy barrier: " << e.what() << endl;
             return false;
@@ -150,13 +187,11 @@ int main() {
     int successCount = 0;  // Add this counter
 
     cout << "Starting simulation with " << nn << " iterations...\n";
+    cout << "GF(2) kernels: " << gf2IsaName(activeGf2Isa()) << "\n";
 
     // Use thread-local random generators
     random_device rd;
     
-    // Create a mutex for synchronized console output
-    #pragma omp declare reduction(|| : bool : omp_out = omp_out || omp_in)
-
     #pragma omp parallel reduction(+:successCount)  // Add reduction for successCount
     {
         mt19937 local_gen(rd() + omp_get_thread_num()); // Different seed for each thread
@@ -179,23 +214,16 @@ int main() {
             vector<vector<int>> H1, H2, H3;
             vector<int> codewords1, codewords2, codewords3;
             int d1, E1, d2, E2, E3;
+            SearchStatus e3Status = SearchStatus::Complete;
 
-            auto start = chrono::steady_clock::now();
+            // Trials give up cooperatively after 5 seconds
+            SearchLimits limits = SearchLimits::withTimeout(5.0);
             bool success = false;
             
             try {
                 success = runSingleSimulation(m1, n1, m2, n2, w, H1, H2, H3, 
                                             d1, E1, d2, E2, E3,
-                                            codewords1, codewords2, codewords3);
-                
-                auto current = chrono::steady_clock::now();
-                if (chrono::duration_cast<chrono::seconds>(current - start).count() > 5) {
-                    #pragma omp critical
-                    {
-                        cout << "\nIteration " << iter << " timed out, skipping...\n";
-                    }
-                    continue;
-                }
+                                            codewords1, codewords2, codewords3, limits, e3Status);
             } catch (const exception& e) {
                 #pragma omp critical
                 {
@@ -243,7 +271,12 @@ int main() {
                         }
                         cout << "\n\n";
 
-                        cout << "H3 (tensor product): E3=" << E3 << "\n";
+                        if (e3Status == SearchStatus::Complete) {
+                            cout << "H3 (tensor product): E3=" << E3 << "\n";
+                        } else {
+                            cout << "H3 (tensor product): E3<=" << E3 << " (upper bound, exact search "
+                                 << searchStatusName(e3Status) << ")\n";
+                        }
                         // Print H3
                         cout << "H3 matrix:\n";
                         for (const auto& row : H3) {
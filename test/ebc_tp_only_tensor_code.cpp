@@ -65,15 +65,16 @@ int main() {
     int minBarrier = INT_MAX;
     string minBarrierCodeword;
 
-    for(const auto& cw : codewords) {
+    // Energy barriers of all codewords from a single search
+    vector<int> barriers = computeEnergyBarrierProfile(H3, codewords);
+
+    for(size_t k = 0; k < codewords.size(); k++) {
+        const string& cw = codewords[k];
+
         // Skip the zero codeword (all zeros)
         if(cw.find('1') == string::npos) continue;
         
-        // Convert string codeword to vector<int>
-        vector<int> codewordVec = stringToVector(cw);
-        
-        // Compute energy barrier for this codeword
-        int barrier = computeEnergyBarrier(H3, codewordVec);
+        int barrier = barriers[k];
         
         cout << "Energy barrier for codeword " << cw << ": " << barrier << endl;
         